@@ -0,0 +1,59 @@
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+//Linked into pca_alloc instead of the default allocator: counts every
+//operator new issued during a compilation and reports it on exit.
+
+namespace
+{
+	std::atomic<unsigned long long> allocations{0};
+	std::atomic<unsigned long long> allocated_bytes{0};
+
+	struct Report
+	{
+		~Report()
+		{
+			std::fprintf(stderr, "allocations: %llu\tbytes: %llu\n", allocations.load(), allocated_bytes.load());
+		}
+	} report;
+}
+
+void* operator new(std::size_t size)
+{
+	++allocations;
+	allocated_bytes += size;
+
+	if (void* ptr = std::malloc(size == 0 ? 1 : size))
+	{
+		return ptr;
+	}
+
+	throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+	return ::operator new(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+	std::free(ptr);
+}
@@ -0,0 +1,45 @@
+#include "arena.hpp"
+#include <algorithm>
+#include <cstdint>
+
+void* Arena::allocate(std::size_t size, std::size_t align)
+{
+	while (true)
+	{
+		if (this->current == this->chunks.size())
+		{
+			auto chunk_size = std::max(this->chunk_size, size + align);
+			this->chunks.push_back(Chunk{std::make_unique<char[]>(chunk_size), chunk_size});
+		}
+
+		auto& chunk = this->chunks[this->current];
+		auto base = reinterpret_cast<std::uintptr_t>(chunk.data.get());
+		auto aligned = ((base + this->offset + align - 1) & ~(align - 1)) - base;
+
+		if (aligned + size <= chunk.size)
+		{
+			this->offset = aligned + size;
+			return chunk.data.get() + aligned;
+		}
+
+		//a retained chunk too small for an oversized request is skipped until the next release
+		++this->current;
+		this->offset = 0;
+	}
+}
+
+Arena::Mark Arena::mark() const
+{
+	return Mark{this->current, this->offset};
+}
+
+void Arena::release(const Mark& mark)
+{
+	this->current = mark.chunk;
+	this->offset = mark.offset;
+}
+
+void Arena::clear()
+{
+	this->release(Mark{0, 0});
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+//Bump allocator for data that dies together. Allocations are carved out of
+//large chunks and given back all at once by rewinding to a mark; chunks stay
+//owned by the arena, so the next subprogram reuses them without calling malloc.
+class Arena
+{
+	public:
+		struct Mark
+		{
+			std::size_t chunk;
+			std::size_t offset;
+		};
+
+	private:
+		struct Chunk
+		{
+			std::unique_ptr<char[]> data;
+			std::size_t size;
+		};
+
+		std::vector<Chunk> chunks;
+		std::size_t current = 0; //chunk being filled
+		std::size_t offset = 0; //first free byte of current chunk
+		std::size_t chunk_size;
+
+	public:
+		explicit Arena(std::size_t chunk_size = Arena::CHUNK_SIZE): chunk_size(chunk_size) {};
+		Arena(const Arena&) = delete;
+		Arena& operator=(const Arena&) = delete;
+
+		void* allocate(std::size_t, std::size_t align = alignof(std::max_align_t));
+		Mark mark() const;
+		void release(const Mark&); //frees everything allocated after the mark
+		void clear();
+
+		constexpr static std::size_t CHUNK_SIZE = 16 * 1024;
+};
@@ -0,0 +1,27 @@
+#include "ast.hpp"
+
+namespace ast
+{
+	Expression* Tree::expression(expression_kind kind, int line, int symbol, int op)
+	{
+		auto node = this->make<Expression>();
+		node->kind = kind;
+		node->line = line;
+		node->symbol = symbol;
+		node->op = op;
+		return node;
+	}
+
+	Statement* Tree::statement(statement_kind kind, int line)
+	{
+		auto node = this->make<Statement>();
+		node->kind = kind;
+		node->line = line;
+		return node;
+	}
+
+	void Tree::clear()
+	{
+		this->arena.clear();
+	}
+}
@@ -0,0 +1,115 @@
+#pragma once
+#include "arena.hpp"
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+//Syntax tree of the statements of one body, built by the parser and walked by
+//SemanticPass and CodeGenerator once the body is complete. Declarations are not
+//part of it: they go to the SymTable while parsing, so every identifier in the
+//tree is already a symbol id. Nodes live in the Tree's arena and die together
+//when the body has been generated.
+namespace ast
+{
+	enum class expression_kind: std::uint8_t
+	{
+		VALUE, //constant, symbol holds its id
+		VARIABLE, //variable or call without parentheses, arguments hold the indices
+		CALL, //function call with parentheses
+		UNARY,
+		BINARY,
+		AND_THEN,
+		OR_ELSE
+	};
+
+	struct Expression
+	{
+		expression_kind kind;
+		int line; //source line the node was completed at, for diagnostics
+		int symbol = -1; //constant, variable or callee
+		int op = 0; //token value of the operator
+		Expression* left = nullptr; //operand of unary operators
+		Expression* right = nullptr;
+		Expression* arguments = nullptr; //indices or call arguments, chained by next
+		Expression* next = nullptr;
+	};
+
+	enum class statement_kind: std::uint8_t
+	{
+		ASSIGN,
+		COMPOUND,
+		CALL,
+		WRITE,
+		READ,
+		IF,
+		WHILE,
+		FOR,
+		FOR_IN, //parsed, but only its body is generated
+		REPEAT
+	};
+
+	struct Statement
+	{
+		statement_kind kind;
+		int line;
+		int symbol = -1; //callee
+		int op = 0; //opcode stepping a for loop
+		Expression* target = nullptr; //assigned or counting variable
+		Expression* value = nullptr; //assigned value, condition or start of a for loop
+		Expression* limit = nullptr; //end of a for loop
+		Expression* arguments = nullptr; //write, read and call arguments, chained by next
+		Statement* body = nullptr; //loop body, then branch or first statement of a block
+		Statement* alternative = nullptr; //else branch
+		Statement* next = nullptr;
+	};
+
+	//Left recursive rules append at the end, so lists keep their last node.
+	template<typename Node>
+	struct List
+	{
+		Node* first;
+		Node* last;
+	};
+
+	using ExpressionList = List<Expression>;
+	using StatementList = List<Statement>;
+
+	class Tree
+	{
+		private:
+			Arena arena;
+
+			template<typename Node>
+			Node* make()
+			{
+				static_assert(std::is_trivially_destructible_v<Node>, "clear() never runs destructors");
+				return new (this->arena.allocate(sizeof(Node), alignof(Node))) Node();
+			}
+
+		public:
+			Expression* expression(expression_kind, int line, int symbol = -1, int op = 0);
+			Statement* statement(statement_kind, int line);
+
+			template<typename Node>
+			static List<Node> list(Node* node)
+			{
+				return List<Node>{node, node};
+			}
+
+			template<typename Node>
+			static List<Node> append(List<Node> list, Node* node)
+			{
+				if (list.last == nullptr)
+				{
+					return Tree::list(node);
+				}
+
+				list.last->next = node;
+				list.last = node;
+				return list;
+			}
+
+			void clear(); //drops every node
+	};
+}
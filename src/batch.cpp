@@ -0,0 +1,150 @@
+#include "batch.hpp"
+#include "compiler.hpp"
+#include "threadpool.hpp"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+
+namespace
+{
+	struct Outcome
+	{
+		bool succeeded = false;
+		double milliseconds = 0;
+		std::string diagnostics;
+	};
+
+	double elapsed_ms(std::chrono::steady_clock::time_point since)
+	{
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - since).count();
+	}
+}
+
+Batch::Batch(std::vector<std::string> inputs, unsigned jobs, SubprogramCache* cache): inputs(std::move(inputs)), jobs(jobs), cache(cache)
+{
+}
+
+std::vector<std::string> Batch::expand(const std::vector<std::string>& args)
+{
+	std::vector<std::string> inputs;
+
+	for (const auto& arg : args)
+	{
+		if (arg.empty() or arg.front() != '@')
+		{
+			inputs.push_back(arg);
+			continue;
+		}
+
+		std::ifstream manifest(arg.substr(1));
+		if (not manifest.is_open())
+		{
+			throw CompilerException(interpolate("Runtime error. Provided manifest: \"{0}\" does not exist.", arg.substr(1)), -1);
+		}
+
+		for (std::string line; std::getline(manifest, line);)
+		{
+			line.erase(std::find_if(line.rbegin(), line.rend(), [](unsigned char c) { return not std::isspace(c); }).base(), line.end());
+			if (not line.empty() and line.front() != '#')
+			{
+				inputs.push_back(line);
+			}
+		}
+	}
+
+	return inputs;
+}
+
+std::string Batch::output_name(const std::string& input)
+{
+	auto slash = input.find_last_of('/');
+	auto dot = input.find_last_of('.');
+
+	if (dot == std::string::npos or (slash != std::string::npos and dot < slash))
+	{
+		return input + ".asm";
+	}
+
+	return input.substr(0, dot) + ".asm";
+}
+
+int Batch::compile(std::ostream& out)
+{
+	std::vector<Outcome> outcomes(this->inputs.size());
+	std::mutex report;
+	auto start = std::chrono::steady_clock::now();
+
+	{
+		ThreadPool pool(this->jobs);
+
+		for (std::size_t i = 0; i < this->inputs.size(); ++i)
+		{
+			pool.submit([this, i, &outcomes, &report, &out]()
+			{
+				auto& outcome = outcomes[i];
+				std::ostringstream diagnostics;
+				auto begin = std::chrono::steady_clock::now();
+
+				try
+				{
+					Compiler compiler(this->inputs[i], Batch::output_name(this->inputs[i]));
+					compiler.set_listing(nullptr);
+					compiler.set_diagnostics(&diagnostics);
+					compiler.set_cache(this->cache);
+					compiler.compile();
+					outcome.succeeded = compiler.succeeded();
+				}
+				catch (const std::exception& exc)
+				{
+					diagnostics << exc.what() << std::endl;
+				}
+
+				outcome.milliseconds = elapsed_ms(begin);
+				outcome.diagnostics = diagnostics.str();
+
+				if (not outcome.diagnostics.empty())
+				{
+					std::lock_guard<std::mutex> lock(report);
+					out << this->inputs[i] << ":\n" << outcome.diagnostics;
+				}
+			});
+		}
+
+		pool.wait();
+	}
+
+	auto wall = elapsed_ms(start);
+	auto failed = std::count_if(outcomes.cbegin(), outcomes.cend(), [](const Outcome& outcome) { return not outcome.succeeded; });
+	double busy = 0;
+	std::size_t slowest = 0;
+
+	for (std::size_t i = 0; i < outcomes.size(); ++i)
+	{
+		busy += outcomes[i].milliseconds;
+		if (outcomes[i].milliseconds > outcomes[slowest].milliseconds)
+		{
+			slowest = i;
+		}
+	}
+
+	out << std::fixed << std::setprecision(2)
+		<< "compiled " << outcomes.size() - failed << "/" << outcomes.size() << " files"
+		<< " in " << wall << " ms on " << std::max(this->jobs, 1u) << " threads"
+		<< " (compile time " << busy << " ms, " << (wall > 0 ? outcomes.size() * 1000.0 / wall : 0) << " files/s)" << std::endl;
+
+	if (not outcomes.empty())
+	{
+		out << "slowest: " << this->inputs[slowest] << " (" << outcomes[slowest].milliseconds << " ms)" << std::endl;
+	}
+
+	if (this->cache != nullptr)
+	{
+		out << "subprogram cache: " << this->cache->hit_count() << " hits, " << this->cache->miss_count() << " misses" << std::endl;
+	}
+
+	return failed;
+}
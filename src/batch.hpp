@@ -0,0 +1,23 @@
+#pragma once
+#include "subprogramcache.hpp"
+#include <ostream>
+#include <string>
+#include <vector>
+
+//Compiles many sources in one process on a work-stealing pool. Every input is
+//written to its own .asm next to it; a failing file is reported and skipped.
+class Batch
+{
+	private:
+		std::vector<std::string> inputs;
+		unsigned jobs;
+		SubprogramCache* cache; //none when null
+
+	public:
+		Batch(std::vector<std::string> inputs, unsigned jobs, SubprogramCache* cache = nullptr);
+
+		int compile(std::ostream&); //returns the number of failed files
+
+		static std::vector<std::string> expand(const std::vector<std::string>&); //"@file" arguments name manifests, one path per line
+		static std::string output_name(const std::string&);
+};
@@ -0,0 +1,56 @@
+#include "chunkbuffer.hpp"
+#include "outputfile.hpp"
+
+void ChunkBuffer::seal()
+{
+	if (this->pptr() != this->pbase())
+	{
+		this->pieces.push_back(iovec{this->pbase(), static_cast<std::size_t>(this->pptr() - this->pbase())});
+	}
+	this->setp(nullptr, nullptr);
+}
+
+ChunkBuffer::int_type ChunkBuffer::overflow(int_type ch)
+{
+	this->seal();
+
+	auto chunk = static_cast<char*>(this->arena.allocate(ChunkBuffer::CHUNK_SIZE, 1));
+	this->setp(chunk, chunk + ChunkBuffer::CHUNK_SIZE);
+
+	if (traits_type::eq_int_type(ch, traits_type::eof()))
+	{
+		return traits_type::not_eof(ch);
+	}
+
+	*this->pptr() = traits_type::to_char_type(ch);
+	this->pbump(1);
+	return ch;
+}
+
+void ChunkBuffer::commit(std::ostream& out, std::string* copy)
+{
+	this->seal();
+
+	if (copy != nullptr)
+	{
+		for (const auto& piece : this->pieces)
+		{
+			copy->append(static_cast<const char*>(piece.iov_base), piece.iov_len);
+		}
+	}
+
+	if (auto file = dynamic_cast<OutputFile*>(out.rdbuf()))
+	{
+		file->splice(this->pieces.data(), this->pieces.size());
+	}
+	else
+	{
+		for (const auto& piece : this->pieces)
+		{
+			out.write(static_cast<const char*>(piece.iov_base), piece.iov_len);
+		}
+	}
+
+	this->pieces.clear();
+	this->arena.clear();
+}
@@ -0,0 +1,33 @@
+#pragma once
+#include "arena.hpp"
+#include <cstddef>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <sys/uio.h>
+#include <vector>
+
+//Stream buffer for the text of a finished subprogram on its way to the output.
+//Text goes into arena chunks; commit() writes them out in order and rewinds
+//the arena, so printing the next subprogram reuses the same memory. Committing
+//to an OutputFile hands the chunks over as they are instead of copying them.
+class ChunkBuffer: public std::streambuf
+{
+	private:
+		Arena arena;
+		std::vector<iovec> pieces; //filled chunks, in print order
+
+		void seal();
+
+	protected:
+		int_type overflow(int_type) override;
+
+	public:
+		ChunkBuffer(): arena(ChunkBuffer::CHUNK_SIZE) {};
+		ChunkBuffer(const ChunkBuffer&) = delete;
+		ChunkBuffer& operator=(const ChunkBuffer&) = delete;
+
+		void commit(std::ostream&, std::string* copy = nullptr); //the text is also appended to copy, when given
+
+		constexpr static std::size_t CHUNK_SIZE = 4 * 1024;
+};
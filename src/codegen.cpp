@@ -0,0 +1,281 @@
+#include "codegen.hpp"
+#include "emitter.hpp"
+
+void CodeGenerator::run(const ast::Statement* body)
+{
+	this->statement(body);
+}
+
+void CodeGenerator::statement(const ast::Statement* node)
+{
+	for (; node != nullptr; node = node->next)
+	{
+		switch (node->kind)
+		{
+			case ast::statement_kind::ASSIGN:
+			{
+				auto target = this->variable(node->target, true);
+				auto value = this->expression(node->value);
+				this->lineno = node->line;
+				this->emitter.assign(target, value);
+				break;
+			}
+			case ast::statement_kind::COMPOUND:
+			case ast::statement_kind::FOR_IN:
+			{
+				this->statement(node->body);
+				break;
+			}
+			case ast::statement_kind::CALL:
+			{
+				this->emitter.begin_parametric_expr();
+				this->arguments(node->arguments);
+				this->lineno = node->line;
+				this->emitter.make_call(node->symbol, false);
+				this->emitter.end_parametric_expr();
+				break;
+			}
+			case ast::statement_kind::WRITE:
+			{
+				this->emitter.begin_parametric_expr();
+				this->arguments(node->arguments);
+				this->lineno = node->line;
+				this->emitter.write();
+				this->emitter.end_parametric_expr();
+				break;
+			}
+			case ast::statement_kind::READ:
+			{
+				this->emitter.begin_parametric_expr();
+				for (auto target = node->arguments; target != nullptr; target = target->next)
+				{
+					this->emitter.store_param(this->variable(target, true));
+				}
+				this->lineno = node->line;
+				this->emitter.read();
+				this->emitter.end_parametric_expr();
+				break;
+			}
+			case ast::statement_kind::IF:
+			{
+				int else_label;
+				if (CodeGenerator::is_jumping(node->value))
+				{
+					else_label = this->emitter.make_label("else");
+					this->condition(node->value, else_label, false);
+				}
+				else
+				{
+					auto condition = this->expression(node->value);
+					this->lineno = node->value->line;
+					else_label = this->emitter.if_statement(condition);
+				}
+
+				this->statement(node->body);
+				this->lineno = node->body->line;
+				auto end_label = this->emitter.end_if();
+
+				this->emitter.label(else_label);
+				this->statement(node->alternative);
+				this->lineno = node->line;
+				this->emitter.label(end_label);
+				break;
+			}
+			case ast::statement_kind::WHILE:
+			{
+				this->lineno = node->line;
+				auto loop_label = this->emitter.begin_while();
+				int exit_label;
+				if (CodeGenerator::is_jumping(node->value))
+				{
+					exit_label = this->emitter.make_label("endwhile");
+					this->condition(node->value, exit_label, false);
+				}
+				else
+				{
+					auto condition = this->expression(node->value);
+					this->lineno = node->value->line;
+					exit_label = this->emitter.while_statement(condition);
+				}
+
+				this->statement(node->body);
+				this->lineno = node->line;
+				this->emitter.jump(loop_label);
+				this->emitter.label(exit_label);
+				break;
+			}
+			case ast::statement_kind::FOR:
+			{
+				auto counter = this->variable(node->target, true);
+				auto start = this->expression(node->value);
+				auto stop = this->expression(node->limit);
+				this->lineno = node->limit->line;
+				auto [loop_label, exit_label] = this->emitter.classic_for_statement(counter, start, node->op, stop);
+
+				this->statement(node->body);
+				this->lineno = node->line;
+				this->emitter.classic_end_iteration(counter, node->op, loop_label);
+				this->emitter.label(exit_label);
+				break;
+			}
+			case ast::statement_kind::REPEAT:
+			{
+				this->lineno = node->line;
+				auto loop_label = this->emitter.repeat();
+				this->statement(node->body);
+				if (CodeGenerator::is_jumping(node->value))
+				{
+					this->condition(node->value, loop_label, true);
+				}
+				else
+				{
+					auto condition = this->expression(node->value);
+					this->lineno = node->line;
+					this->emitter.until(loop_label, condition);
+				}
+				break;
+			}
+		}
+	}
+}
+
+int CodeGenerator::expression(const ast::Expression* node)
+{
+	switch (node->kind)
+	{
+		case ast::expression_kind::VALUE:
+		{
+			return node->symbol;
+		}
+		case ast::expression_kind::VARIABLE:
+		{
+			return this->variable(node);
+		}
+		case ast::expression_kind::CALL:
+		{
+			this->emitter.begin_parametric_expr();
+			this->arguments(node->arguments);
+			this->lineno = node->line;
+			auto result = this->emitter.make_call(node->symbol, true).value_or(SymTable::NONE);
+			this->emitter.end_parametric_expr();
+			return result;
+		}
+		case ast::expression_kind::UNARY:
+		{
+			auto operand = this->expression(node->left);
+			this->lineno = node->line;
+			return this->emitter.unary_op(node->op, operand);
+		}
+		case ast::expression_kind::BINARY:
+		{
+			auto left = this->expression(node->left);
+			auto right = this->expression(node->right);
+			this->lineno = node->line;
+			return this->emitter.binary_op(node->op, left, right);
+		}
+		case ast::expression_kind::AND_THEN:
+		case ast::expression_kind::OR_ELSE:
+		{
+			auto false_label = this->emitter.make_label("condfalse");
+			this->condition(node, false_label, false);
+			this->lineno = node->line;
+			return this->emitter.materialize(false_label);
+		}
+	}
+
+	return SymTable::NONE;
+}
+
+//Indices are evaluated inside the variable's own parametric expression, which
+//variable_or_call consumes.
+int CodeGenerator::variable(const ast::Expression* node, bool lvalue)
+{
+	this->emitter.begin_parametric_expr();
+	this->arguments(node->arguments);
+	this->lineno = node->line;
+	auto result = this->emitter.variable_or_call(node->symbol, lvalue);
+	this->emitter.end_parametric_expr();
+	return result;
+}
+
+void CodeGenerator::arguments(const ast::Expression* node)
+{
+	for (; node != nullptr; node = node->next)
+	{
+		this->emitter.store_param(this->expression(node));
+	}
+}
+
+//Jumps to the target when the truth of the condition is as given and falls
+//through otherwise. Short-circuit operands jump straight to where their value
+//decides the outcome, so no operand is turned into a value.
+void CodeGenerator::condition(const ast::Expression* node, int target, bool when)
+{
+	switch (node->kind)
+	{
+		case ast::expression_kind::AND_THEN:
+		case ast::expression_kind::OR_ELSE:
+		{
+			//a false operand decides and then, a true one or else
+			bool decisive = node->kind == ast::expression_kind::OR_ELSE;
+			if (when == decisive)
+			{
+				this->condition(node->left, target, when);
+				this->condition(node->right, target, when);
+				return;
+			}
+
+			auto decided = this->emitter.make_label("shortcut");
+			this->condition(node->left, decided, decisive);
+			this->condition(node->right, target, when);
+			this->emitter.label(decided);
+			return;
+		}
+		case ast::expression_kind::BINARY:
+		{
+			if (CodeGenerator::is_relation(node))
+			{
+				auto left = this->expression(node->left);
+				auto right = this->expression(node->right);
+				this->lineno = node->line;
+				this->emitter.branch(node->op, left, right, target, when);
+				return;
+			}
+			break;
+		}
+		default:
+			break;
+	}
+
+	auto value = this->expression(node);
+	this->lineno = node->line;
+	this->emitter.branch_on(value, target, when);
+}
+
+//Relations steering control flow jump on their own operands; their 0 or 1 is
+//only materialized where the value is stored or passed.
+bool CodeGenerator::is_relation(const ast::Expression* node)
+{
+	if (node->kind != ast::expression_kind::BINARY)
+	{
+		return false;
+	}
+
+	switch (static_cast<opcode>(node->op))
+	{
+		case opcode::EQ:
+		case opcode::NE:
+		case opcode::LT:
+		case opcode::LE:
+		case opcode::GT:
+		case opcode::GE:
+			return true;
+		default:
+			return false;
+	}
+}
+
+bool CodeGenerator::is_jumping(const ast::Expression* node)
+{
+	return node->kind == ast::expression_kind::AND_THEN or node->kind == ast::expression_kind::OR_ELSE or CodeGenerator::is_relation(node);
+}
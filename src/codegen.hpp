@@ -0,0 +1,28 @@
+#pragma once
+#include "ast.hpp"
+
+class Emitter;
+
+//Second pass over a finished body: drives the Emitter through the tree in the
+//order the parser's actions used to, so the output is the same as when code
+//was generated while parsing.
+class CodeGenerator
+{
+	private:
+		Emitter& emitter;
+		int& lineno; //moved to each node's line, so errors point at the source
+
+		void statement(const ast::Statement*);
+		int expression(const ast::Expression*);
+		int variable(const ast::Expression*, bool lvalue = false);
+		void arguments(const ast::Expression*); //stored as parameters of the innermost parametric expression
+		void condition(const ast::Expression*, int target, bool when);
+
+		static bool is_relation(const ast::Expression*);
+		static bool is_jumping(const ast::Expression*); //conditions compiled to jumps rather than to a value
+
+	public:
+		CodeGenerator(Emitter& emitter, int& lineno): emitter(emitter), lineno(lineno) {};
+
+		void run(const ast::Statement*);
+};
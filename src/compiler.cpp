@@ -2,29 +2,91 @@
 
 void Compiler::compile()
 {
-	this->parse_result = yyparse();
+	yyscan_t scanner;
+	yylex_init_extra(&this->context, &scanner);
 
-	this->output.close();
-	std::fclose(this->input);
-	this->input = nullptr;
+	if(this->source.is_mapped())
+	{
+		this->context.source = std::string_view(this->source.data(), this->source.size() - SourceFile::PADDING);
+		scan_source(this->source.data(), this->source.size(), scanner);
+	}
+	else if(this->input != nullptr)
+	{
+		yyset_in(this->input, scanner);
+	}
+	else
+	{
+		this->context.source = std::string_view(this->text.data(), this->text.size() - SourceFile::PADDING);
+		scan_source(this->text.data(), this->text.size(), scanner);
+	}
 
-	if(this->parse_result != 0)
+	if(this->context.cache != nullptr)
+	{
+		this->context.extents = SubprogramCache::outline(this->context.source);
+	}
+
+	this->parse_result = yyparse(scanner, this->context);
+	yylex_destroy(scanner);
+
+	bool written = this->output_file.close();
+	this->source.unmap();
+	if(this->input != nullptr)
+	{
+		std::fclose(this->input);
+		this->input = nullptr;
+	}
+
+	if(this->parse_result != 0 or not written)
+	{
+		this->discard_output();
+	}
+
+	if(not written)
+	{
+		throw CompilerException(interpolate("Runtime error. Cannot write output file: \"{0}\".", this->output_file_name), -1);
+	}
+}
+
+void Compiler::discard_output()
+{
+	this->output_file.close();
+	if(this->output_file.is_regular() and not this->output_file_name.empty())
 	{
 		std::remove(this->output_file_name.c_str());
 	}
 }
 
-std::shared_ptr<SymTable> Compiler::share_table()
+bool Compiler::succeeded() const
+{
+	return this->parse_result == 0;
+}
+
+void Compiler::set_compact(bool compact)
+{
+	this->context.emitter.set_compact(compact);
+}
+
+void Compiler::set_annotate(bool annotate)
+{
+	this->context.emitter.set_annotate(annotate);
+}
+
+void Compiler::set_listing(std::ostream* listing, dump_format format)
+{
+	this->context.emitter.set_listing(listing, format);
+}
+
+void Compiler::set_diagnostics(std::ostream* diagnostics)
 {
-	return std::make_shared<SymTable>((this->symtable));
+	this->context.diagnostics = diagnostics;
 }
 
-std::shared_ptr<Emitter> Compiler::share_emitter()
+void Compiler::set_cache(SubprogramCache* cache)
 {
-	return std::make_shared<Emitter>((this->emitter));
+	this->context.cache = cache;
 }
 
-std::FILE* Compiler::get_istream() const
+const std::vector<Diagnostic>& Compiler::errors() const
 {
-	return this->input;
+	return this->context.errors;
 }
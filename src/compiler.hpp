@@ -1,46 +1,73 @@
-#include "emitter.hpp"
+#include "context.hpp"
+#include "sourcefile.hpp"
+#include "outputfile.hpp"
 #include <cstdio>
 #include <cstdlib>
-#include <fstream>
 #include <memory>
+#include <string>
+#include <string_view>
 
-extern int yyparse();
+typedef void* yyscan_t;
+
+extern int yyparse(yyscan_t, Context&);
+extern int yylex_init_extra(Context*, yyscan_t*);
+extern int yylex_destroy(yyscan_t);
+extern void yyset_in(std::FILE*, yyscan_t);
+extern void scan_source(char*, std::size_t, yyscan_t);
 
 class Compiler
 {
 	private:
 		std::string file_name;
 		std::string output_file_name;
-		std::ofstream output;
-		Emitter emitter;
-		SymTable symtable;
-		std::FILE* input;
+		OutputFile output_file; //file mode only
+		std::ostream output{&this->output_file};
+		Context context;
+		SourceFile source;
+		std::FILE* input = nullptr; //used when the source cannot be mapped
+		std::string text; //in-memory source, padded for in-place scanning
 		int parse_result = 0;
+
+		void discard_output(); //removes a partial output file, leaving devices such as /dev/null alone
 	
 	public:
-		std::shared_ptr<SymTable> share_table();
-		std::shared_ptr<Emitter> share_emitter();
 		void compile();
+		bool succeeded() const;
+		void set_listing(std::ostream*, dump_format = dump_format::TABLE);
+		void set_compact(bool);
+		void set_annotate(bool);
+		void set_diagnostics(std::ostream*);
+		void set_cache(SubprogramCache*); //subprograms are cached only for sources scanned in place
+		const std::vector<Diagnostic>& errors() const;
 		Compiler(std::string file_name, std::string output_file_name="out.asm"):
 																	   file_name(file_name),
 																	   output_file_name(output_file_name), 
-																	   output(output_file_name),
-																	   emitter(output)
+																	   context(output)
 		{
-			if(not this->output.is_open())
+			if(not this->output_file.open(this->output_file_name))
 			{
 				throw CompilerException(interpolate("Runtime error. Provided output file: \"{0}\" does not exist.", this->output_file_name), -1);
 			}
 
+			if(this->source.map(this->file_name))
+			{
+				return;
+			}
+
 			this->input = std::fopen(this->file_name.c_str(), "r");
 			
 			if(input == NULL)
 			{
-				this->output.close();
-				std::remove(this->output_file_name.c_str());
+				this->discard_output();
 				throw CompilerException(interpolate("Runtime error. Provided input file: \"{0}\" does not exist.", this->file_name), -1);
 			}
 		}
 
-		std::FILE* get_istream() const;
+		//compiles source text held in memory into the given stream without touching any file
+		Compiler(std::string_view source_text, std::ostream& output): context(output)
+		{
+			this->text.reserve(source_text.size() + SourceFile::PADDING);
+			this->text.assign(source_text);
+			this->text.append(SourceFile::PADDING, '\0');
+		}
 };
\ No newline at end of file
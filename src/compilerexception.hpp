@@ -5,9 +5,10 @@ class CompilerException: public std::exception
 {
 	private:
 		std::string message;
+		std::string description; //message without the line suffix
 	public:
 		const int lineno;
-		CompilerException(const std::string& what, const int lineno):  lineno(lineno){
+		CompilerException(const std::string& what, const int lineno):  description(what), lineno(lineno){
 			auto s = (what + (lineno >= 0 ? "\tEncountered at line: " + std::to_string(this->lineno) : ""));
 			message = s;
 		};
@@ -16,4 +17,9 @@ class CompilerException: public std::exception
 		{
 			return this->message.c_str();
 		}
+
+		const std::string& reason() const noexcept
+		{
+			return this->description;
+		}
 };
\ No newline at end of file
@@ -0,0 +1,82 @@
+#include "context.hpp"
+#include "semantic.hpp"
+#include "codegen.hpp"
+#include <algorithm>
+
+//Runs while the scanner still stands right after the header's ';': the parser
+//reduces a header without reading a lookahead token, so a hit can still be
+//passed over before any token of the body is scanned.
+void Context::probe_cache()
+{
+	this->pending_key.clear();
+
+	if (this->cache == nullptr or this->source.empty() or this->subprogram_start == nullptr)
+	{
+		return;
+	}
+
+	std::size_t start = this->subprogram_start - this->source.data();
+	auto extent = std::lower_bound(this->extents.cbegin(), this->extents.cend(), start, [](const SubprogramCache::Extent& extent, std::size_t start)
+	{
+		return extent.start < start;
+	});
+
+	if (extent == this->extents.cend() or extent->start != start)
+	{
+		return;
+	}
+
+	//the program head lies wholly behind the scanner, so it still reads as written
+	if (this->declarations.empty())
+	{
+		auto version = std::string(SubprogramCache::VERSION).append(this->emitter.is_compact() ? "/compact" : "").append(this->emitter.is_annotated() ? "" : "/plain").append(this->emitter.listing_tag());
+		this->declarations = SubprogramCache::digest(version, this->source.substr(0, this->extents.front().start));
+	}
+
+	auto key = SubprogramCache::digest(this->declarations + this->symtab.label_counters(), extent->text);
+	this->declarations = SubprogramCache::digest(this->declarations, extent->header);
+
+	if (auto entry = this->cache->load(key))
+	{
+		this->cached = std::move(*entry);
+		this->skip = extent->body_end - extent->header_end;
+	}
+	else
+	{
+		this->pending_key = key;
+	}
+}
+
+void Context::end_subprogram(int id)
+{
+	if (this->pending_key.empty())
+	{
+		this->emitter.end_current_subprogram(id);
+		return;
+	}
+
+	CachedSubprogram record;
+	this->emitter.end_current_subprogram(id, &record);
+	record.labels = this->symtab.label_counters();
+	this->cache->store(this->pending_key, record);
+	this->pending_key.clear();
+}
+
+void Context::splice_subprogram()
+{
+	this->emitter.splice_subprogram(this->cached);
+	this->cached = CachedSubprogram();
+}
+
+//The passes move lineno to the nodes they visit, so a failure is reported at
+//its node; the scanner's line is restored once they are done.
+void Context::generate(ast::Statement* body)
+{
+	auto line = this->lineno;
+
+	SemanticPass(this->symtab, this->lineno).run(body);
+	CodeGenerator(this->emitter, this->lineno).run(body);
+
+	this->lineno = line;
+	this->tree.clear();
+}
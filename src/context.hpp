@@ -0,0 +1,42 @@
+#pragma once
+#include "emitter.hpp"
+#include "ast.hpp"
+#include "diagnostic.hpp"
+#include "subprogramcache.hpp"
+#include <iostream>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+//Everything one compilation mutates. The scanner reaches it through yyextra and
+//the parser through its parse parameter, so compilations share no state and
+//may run on separate threads.
+struct Context
+{
+	int lineno = 1;
+	SymTable symtab;
+	Emitter emitter;
+	std::string backup; //integer part of a real literal split by the lexer
+	ast::Tree tree; //statements of the body being parsed
+	std::ostream* diagnostics = &std::cerr; //printed syntax and semantic errors, none when null
+	std::vector<Diagnostic> errors; //the same errors with their lines kept apart
+
+	SubprogramCache* cache = nullptr; //shared with other compilations, none when null
+	std::string_view source; //text scanned in place, needed to key cached subprograms
+	std::vector<SubprogramCache::Extent> extents; //subprograms found in source, in order
+	const char* subprogram_start = nullptr; //keyword of the latest subprogram, set by the scanner
+	std::size_t skip = 0; //bytes of a cached body the scanner passes over before returning CACHED
+	std::string declarations; //digest of the program head and the headers seen so far
+	std::string pending_key; //key the subprogram being compiled is stored under
+	CachedSubprogram cached; //hit waiting to be spliced
+
+	void probe_cache(); //at the end of a header: arranges for a hit to be skipped
+	void end_subprogram(int);
+	void splice_subprogram();
+	void generate(ast::Statement*); //runs the passes over a finished body and drops its tree
+
+	explicit Context(std::ostream& output): symtab(lineno), emitter(output, symtab, lineno) {};
+	Context(const Context&) = delete;
+	Context& operator=(const Context&) = delete;
+};
@@ -0,0 +1,9 @@
+#pragma once
+#include <string>
+
+//Error reported by a compilation, kept apart from its printed form.
+struct Diagnostic
+{
+	int line; //negative when the error is not tied to a source line
+	std::string message;
+};
@@ -1,35 +1,15 @@
 #include "emitter.hpp"
 #include <cstdlib>
 
-const std::map<opcode, std::string> Emitter::mnemonics = {
-	{opcode::ADD,       "add"},
-	{opcode::NOT,       "not"},
-	{opcode::SUB,       "sub"},
-	{opcode::MUL,       "mul"},
-	{opcode::DIV,       "div"},
-	{opcode::MOD,       "mod"},
-	{opcode::AND,       "and"},
-	{opcode::OR,         "or"},
-	{opcode::NE,        "jne"},
-	{opcode::LE,        "jle"},
-	{opcode::LT,         "jl"},
-	{opcode::GE,        "jge"},
-	{opcode::GT,         "jg"},
-	{opcode::EQ,         "je"},
-	{opcode::I2R, "inttoreal"},
-	{opcode::R2I, "realtoint"},
-	{opcode::MOV,       "mov"},
-	{opcode::JMP,      "jump"},
-	{opcode::WRT,     "write"},
-	{opcode::RD,       "read"},
-	{opcode::PSH,      "push"},
-	{opcode::CALL,     "call"},
-	{opcode::ENTER,	  "enter"},
-	{opcode::INCSP,   "incsp"},
-	{opcode::RET,    "return"},
-	{opcode::LEAVE,   "leave"},
-	{opcode::EXIT,     "exit"}
-};
+std::string_view Emitter::mnemonic(opcode opcd) const
+{
+	auto mnemonic = MNEMONICS[static_cast<std::size_t>(opcd)];
+	if (mnemonic.empty())
+	{
+		throw CompilerException(interpolate("Unknown error. No mnemonic for opcode: {0}", opcd), lineno);
+	}
+	return mnemonic;
+}
 
 std::vector<int> Emitter::get_params()
 {
@@ -43,115 +23,98 @@ void Emitter::clear_params()
 
 int Emitter::get_item(int array_id)
 {
-	auto array = symtab_ptr->get(array_id);
+	const auto& array = this->symtab.get(array_id);
 	if (array.m_entry != entry::ARR)
 	{
 		throw CompilerException(interpolate("Syntax error. {0} is not subscriptable.", array.m_entry), lineno);
 	}
 
-	auto dim_ids = this->params;
-
-	if(dim_ids.empty())
+	if(this->params.empty())
 	{
 		return array_id;
 	}
 
-	std::vector<Symbol> dims;
-
-	std::transform(dim_ids.cbegin(), dim_ids.cend(), std::inserter(dims, dims.begin()), [this](auto symbol_id)
-	{
-		return symtab_ptr->get(symbol_id);
-	});
-
-	return this->reduce(array, dims);
+	return this->reduce(array, this->params);
 } 
 
-int Emitter::reduce(Symbol& array, std::vector<Symbol>& dims)
+int Emitter::reduce(const Symbol& array, const std::vector<int>& dim_ids)
 {
-	auto array_type_spec = array.args[0];
+	const auto& array_type_spec = this->symtab.array_type(array);
+	const auto& dim_specs = array_type_spec.dims;
 
-	if (array_type_spec.args.size() < dims.size())
+	if (dim_specs.size() < dim_ids.size())
 	{
-		throw CompilerException(interpolate("Syntax error. Out of array dimensions access: {0} < {1}", array_type_spec.args.size(), dims.size()), lineno);
+		throw CompilerException(interpolate("Syntax error. Out of array dimensions access: {0} < {1}", dim_specs.size(), dim_ids.size()), lineno);
 	}
 
-	auto is_result_arr = array_type_spec.args.size() > dims.size();
+	auto is_result_arr = dim_specs.size() > dim_ids.size();
 
-	auto temp_id = symtab_ptr->insert_temp(array_type_spec.m_dtype, true);
-	auto temp = symtab_ptr->get(temp_id);
+	auto temp_id = this->symtab.insert_temp(array_type_spec.element, true);
+	auto& temp = this->symtab.get(temp_id);
 
 	if (is_result_arr)
 	{
-		std::vector<Symbol> new_dims;
-		new_dims.insert(new_dims.cbegin(), array_type_spec.args.crbegin(), array_type_spec.args.crend() - dims.size());
-		auto temp_type = symtab_ptr->get(symtab_ptr->insert_array_type(new_dims, array_type_spec.m_dtype) - static_cast<int>(dtype::OBJECT));
-		temp.m_entry = entry::ARR;
-		
-		temp.args = {temp_type};
-		temp.start_ind = temp_type.start_ind;
-		temp.stop_ind = temp_type.stop_ind;
-		symtab_ptr->update(temp);
+		std::vector<Bounds> new_dims(dim_specs.cbegin() + dim_ids.size(), dim_specs.cend());
+		this->symtab.set_array_type(temp, this->symtab.insert_array_type(array_type_spec.element, std::move(new_dims)));
+		this->symtab.update(temp);
 	}
 
-	auto offset = symtab_ptr->get(symtab_ptr->insert_temp(dtype::INT));
-
-	std::vector<Symbol> dim_specs(array_type_spec.args.begin(), array_type_spec.args.begin() + dims.size());
-	auto multiplier_sym = symtab_ptr->get(symtab_ptr->insert_temp(dtype::INT));
-	auto temp_2 = symtab_ptr->get(symtab_ptr->insert_temp(dtype::INT));
-	auto temp_3 = symtab_ptr->get(symtab_ptr->insert_temp(dtype::INT));
+	varsize sz;
 
-	this->assign(multiplier_sym, symtab_ptr->get(symtab_ptr->insert_constant("1", dtype::INT)));
-	this->assign(temp_2, symtab_ptr->get(symtab_ptr->insert_constant("0", dtype::INT)));
-	this->assign(offset, symtab_ptr->get(symtab_ptr->insert_constant("0", dtype::INT)));
+	switch (array_type_spec.element) 
+	{
+		case dtype::INT: sz = varsize::INT; break;
+		case dtype::REAL: sz = varsize::REAL; break;
+		default: sz = varsize::NONE; break;
+	};
 
-	if(is_result_arr)
+	//The byte offset is the sum of (index - start) * stride. Strides and starts
+	//come from the type, so constant indices fold into one constant term and
+	//only variable indices cost instructions.
+	long long stride = static_cast<int>(sz);
+	for (auto i = dim_specs.size(); i-- > dim_ids.size();)
 	{
-		for(auto dim : temp.args[0].args)
-		{
-			auto coeff = symtab_ptr->get(symtab_ptr->insert_constant(std::to_string(std::abs(dim.stop_ind - dim.start_ind + 1)), dtype::INT));
-			this->binop(opcode::MUL, multiplier_sym, coeff, &multiplier_sym);
-		}
+		stride *= dim_specs[i].length();
 	}
 
-	for (auto spec_it = dim_specs.rbegin(), dim_it = dims.rbegin(); spec_it < dim_specs.crend(); ++spec_it, ++dim_it)
+	long long constant_offset = 0;
+	const Symbol* offset = nullptr;
+
+	for (int i = dim_ids.size() - 1; i >= 0; --i)
 	{
+		const auto& spec = dim_specs[i];
+		const auto& dim = this->symtab.get(dim_ids[i]);
+
+		constant_offset -= spec.start * stride;
+
 		//Compile-time known accessor
-		if(dim_it->m_entry == entry::NUM)
+		if(dim.m_entry == entry::NUM)
 		{
-			this->check_bounds(*dim_it, *spec_it);
+			this->check_bounds(dim, spec);
+			constant_offset += std::atoi(this->symtab.name(dim).data()) * stride;
 		}
-
-		auto coeff = symtab_ptr->get(symtab_ptr->insert_constant(std::to_string(spec_it->start_ind), dtype::INT));
-
-		this->binop(opcode::SUB, *dim_it, coeff, &temp_3);
-		this->binop(opcode::MUL, multiplier_sym, temp_3, &temp_2);
-		this->binop(opcode::ADD, temp_2, offset, &offset);
-
-		if(spec_it + 1 < dim_specs.crend())
+		else
 		{
-			auto coeff = symtab_ptr->get(symtab_ptr->insert_constant(std::to_string(std::abs(spec_it->stop_ind - spec_it->start_ind + 1)), dtype::INT));
-			this->binop(opcode::MUL, multiplier_sym, coeff, &multiplier_sym);
+			const auto& index = dim.m_dtype != dtype::INT ? this->symtab.get(this->cast(dim, dtype::INT)) : dim;
+			const auto& term = stride == 1 ? index : this->symtab.get(this->binop(opcode::MUL, index, this->symtab.get(this->symtab.insert_constant(std::to_string(stride), dtype::INT))));
+			offset = offset == nullptr ? &term : &this->symtab.get(this->binop(opcode::ADD, *offset, term));
 		}
-	}
 
-	varsize sz;
+		stride *= spec.length();
+	}
 
-	switch (array.args[0].m_dtype) 
+	if (offset == nullptr or constant_offset != 0)
 	{
-		case dtype::INT: sz = varsize::INT; break;
-		case dtype::REAL: sz = varsize::REAL; break;
-		default: sz = varsize::NONE; break;
-	};
-
-	auto size_constant = symtab_ptr->get(symtab_ptr->insert_constant(std::to_string(static_cast<int>(sz)), dtype::INT));
+		const auto& constant = this->symtab.get(this->symtab.insert_constant(std::to_string(constant_offset), dtype::INT));
+		offset = offset == nullptr ? &constant : &this->symtab.get(this->binop(opcode::ADD, *offset, constant));
+	}
 
-	this->binop(opcode::MUL, size_constant, offset, &offset);
-	this->shift_pointer(array, offset, &temp);
+	this->shift_pointer(array, *offset, &temp);
 
 	return temp_id;
 }
 
-void Emitter::move_pointer(Symbol& pointer, Symbol& dest)
+void Emitter::move_pointer(const Symbol& pointer, const Symbol& dest)
 {
 
 	if (dest.m_entry == entry::VAR and dest.m_dtype != dtype::INT)
@@ -159,14 +122,10 @@ void Emitter::move_pointer(Symbol& pointer, Symbol& dest)
 		throw CompilerException(interpolate("Variable is expected to be integer, got {0}", dest.m_dtype), lineno);
 	}
 
-	auto mnemonic = this->mnemonics.at(opcode::MOV);
-	auto op = mnemonic + this->get_type_str(dtype::INT);
-
-	this->emit_to_stream("\t\t", op, interpolate(";\t{0}\t&{1}, &{2}", mnemonic, pointer.name, dest.name), 
-						 pointer.addr_to_str(false), dest.addr_to_str(false));
+	this->emit(opcode::MOV, dtype::INT, Address{pointer, false}, Address{dest, false});
 }
 
-int Emitter::shift_pointer(Symbol& pointer, Symbol& offset, Symbol* result)
+int Emitter::shift_pointer(const Symbol& pointer, const Symbol& offset, const Symbol* result)
 {
 	if (offset.m_entry != entry::NUM and offset.m_entry != entry::VAR)
 	{
@@ -178,21 +137,17 @@ int Emitter::shift_pointer(Symbol& pointer, Symbol& offset, Symbol* result)
 		throw CompilerException(interpolate("Unknown error. Expected integer offset, got: {0}", offset.m_dtype), lineno);
 	}
 
-	auto temp = result == nullptr ? symtab_ptr->get(symtab_ptr->insert_temp(pointer.m_dtype, true)) : *result;
-	auto mnemonic = this->mnemonics.at(opcode::ADD);
-	auto op = mnemonic + this->get_type_str(dtype::INT);
-
-	this->emit_to_stream("\t\t", op, interpolate(";\t{0}\t&{1}, {2}, &{3}", mnemonic, pointer.name, offset.name, temp.name), 
-						 pointer.addr_to_str(false), offset.addr_to_str(true), temp.addr_to_str(false));
+	const auto& temp = result == nullptr ? this->symtab.get(this->symtab.insert_temp(pointer.m_dtype, true)) : *result;
+	this->emit(opcode::ADD, dtype::INT, Address{pointer, false}, Address{offset, true}, Address{temp, false});
 
 	return temp.symtab_id;
 }
 
-void Emitter::check_bounds(Symbol& constant_dim_accessor, Symbol& axis)
+void Emitter::check_bounds(const Symbol& constant_dim_accessor, const Bounds& axis)
 {
-	if(constant_dim_accessor.m_entry != entry::NUM or axis.m_entry != entry::RNG)
+	if(constant_dim_accessor.m_entry != entry::NUM)
 	{
-		throw CompilerException(interpolate("Unknown error. Expected {0} entry and {1} entry, got {2}, {3}", entry::NUM, entry::RNG, constant_dim_accessor.m_entry, axis.m_entry), lineno);
+		throw CompilerException(interpolate("Unknown error. Expected {0} entry, got {1}", entry::NUM, constant_dim_accessor.m_entry), lineno);
 	}
 
 	if(constant_dim_accessor.m_dtype != dtype::INT)
@@ -200,15 +155,15 @@ void Emitter::check_bounds(Symbol& constant_dim_accessor, Symbol& axis)
 		throw CompilerException(interpolate("Syntax error. Expected integer constant got: {0}", constant_dim_accessor.m_dtype),lineno);
 	}
 
-	int index = std::atoi(constant_dim_accessor.name.c_str());
-	if (index < axis.start_ind)
+	int index = std::atoi(this->symtab.name(constant_dim_accessor).data());
+	if (index < axis.start)
 	{
-		throw CompilerException(interpolate("{0} is smaller than the lower bound of axis dimensions {1}..{2}", index, axis.start_ind, axis.stop_ind), lineno);
+		throw CompilerException(interpolate("{0} is smaller than the lower bound of axis dimensions {1}..{2}", index, axis.start, axis.stop), lineno);
 	}
 
-	if(index > axis.stop_ind)
+	if(index > axis.stop)
 	{
-		throw CompilerException(interpolate("{0} is greater than the upper bound of axis dimensions {1}..{2}", index, axis.start_ind, axis.stop_ind), lineno);
+		throw CompilerException(interpolate("{0} is greater than the upper bound of axis dimensions {1}..{2}", index, axis.start, axis.stop), lineno);
 	}
 }
 
@@ -219,7 +174,7 @@ void Emitter::store_param_on_stack(int symbol_id)
 
 int Emitter::variable_or_call(int symbol_id, bool is_lvalue)
 {
-	auto symbol = symtab_ptr->get(symbol_id);
+	const auto& symbol = this->symtab.get(symbol_id);
 	
 	if(symbol.m_entry == entry::VAR)
 	{
@@ -233,7 +188,7 @@ int Emitter::variable_or_call(int symbol_id, bool is_lvalue)
 
 	if(symbol.m_entry == entry::FUNC and is_lvalue)
 	{
-		return  this->variable_or_call(symtab_ptr->lookup(interpolate("${0}_result", symbol.name)), is_lvalue);
+		return  this->variable_or_call(this->symtab.lookup(interpolate("${0}_result", this->symtab.name(symbol))), is_lvalue);
 	}
 	else if(symbol.m_entry == entry::FUNC)
 	{	
@@ -261,38 +216,25 @@ void Emitter::store_param(int id)
 	this->params.push_back(id);
 }
 
-std::string Emitter::get_type_str(const dtype& type)
-{
-	std::string out;
-	switch (type) 
-	{
-		case dtype::REAL:
-		{
-			out =".r";
-			break;
-		}
-		case dtype::INT:
-		{
-			out =".i";
-			break;
-		}
-       	default: break;
-    }
-
-	return out;
-}
-
-int Emitter::negate(Symbol& symbol)
+int Emitter::negate(const Symbol& symbol)
 {
 	if(symbol.m_entry != entry::VAR and symbol.m_entry != entry::NUM)
 	{
 		throw CompilerException("Syntax error. Variable or numeric constant expected as a operand.", lineno);
 	}
 
-	return this->binop(opcode::SUB, symtab_ptr->get(symtab_ptr->insert_label("0")), symbol);
+	if (symbol.m_entry == entry::NUM)
+	{
+		if (auto literal = folding::negation(this->constant(symbol)))
+		{
+			return this->symtab.insert_constant(*literal, symbol.m_dtype);
+		}
+	}
+
+	return this->binop(opcode::SUB, this->symtab.get(this->symtab.insert_constant("0", dtype::INT)), symbol);
 } 	
 
-int Emitter::boolean_negate(Symbol& symbol)
+int Emitter::boolean_negate(const Symbol& symbol)
 {
 	if(symbol.m_entry != entry::VAR and symbol.m_entry != entry::NUM)
 	{
@@ -300,24 +242,18 @@ int Emitter::boolean_negate(Symbol& symbol)
 	}
 
 	auto type = dtype::INT;
-	if (symbol.m_dtype != dtype::INT)
-	{
-		symbol = symtab_ptr->get(this->cast(symbol, type));
-	}
+	const auto& operand = symbol.m_dtype != type ? this->symtab.get(this->cast(symbol, type)) : symbol;
 
-	auto mnemonic = this->mnemonics.at(opcode::NOT);
-	auto op = mnemonic + this->get_type_str(type);
-
-	auto temp = symtab_ptr->get(symtab_ptr->insert_temp(type));
+	const auto& temp = this->symtab.get(this->symtab.insert_temp(type));
 	
-	this->emit_to_stream("\t\t", op, interpolate(";\t{0}\t{1}, {2}", mnemonic, symbol.name, temp.name), symbol.addr_to_str(true), temp.addr_to_str(true));
+	this->emit(opcode::NOT, type, Address{operand, true}, Address{temp, true});
 
 	return temp.symtab_id;
 }
 
 int Emitter::unary_op(int op_id, int operand_id)
 {
-	auto symbol = symtab_ptr->get(operand_id);
+	const auto& symbol = this->symtab.get(operand_id);
 	
 	if(symbol.m_entry != entry::VAR and symbol.m_entry != entry::NUM)
 	{
@@ -345,72 +281,156 @@ void Emitter::start_program(int label_id)
 
 void Emitter::call_program(int symbol_id)
 {
-	auto& symbol = symtab_ptr->get(symbol_id);
+	auto& symbol = this->symtab.get(symbol_id);
 
 	if(symbol.m_scope != scope::UNBOUND)
 	{
-		throw CompilerException(interpolate("Syntax error. Redefinition of \"{0}\" program.", symbol.name), lineno);
+		throw CompilerException(interpolate("Syntax error. Redefinition of \"{0}\" program.", this->symtab.name(symbol)), lineno);
 	}
 
 	symbol.m_scope = scope::GLOBAL;
 	symbol.m_entry = entry::LABEL;
+	this->symtab.update(symbol);
 
 	this->jump(symbol);
 }
 
-void Emitter::commit_subprogram()
+void Emitter::print(ir::Function& code, std::ostream& out)
 {
-	this->output << this->mem.str();
-	this->mem.str("");
+	this->slots.allocate(code, this->symtab);
+	this->printer.print(code, out);
+	code.clear();
 }
 
 void Emitter::leave_subprogram()
 {
-	auto leave_mnemonic = this->mnemonics.at(opcode::LEAVE);
-	auto return_mnemonic = this->mnemonics.at(opcode::RET);
-	this->emit_to_stream("\t\t", leave_mnemonic, interpolate(";\t{0}", leave_mnemonic));
-	this->emit_to_stream("\t\t", return_mnemonic, interpolate(";\t{0}", return_mnemonic));
+	this->emit(opcode::LEAVE, dtype::NONE);
+	this->emit(opcode::RET, dtype::NONE);
 }
 
 void Emitter::enter(int stack_size)
 {
-	auto enter_mnemonic	= this->mnemonics.at(opcode::ENTER);
-	this->emit_to_stream("\t\t", enter_mnemonic + this->get_type_str(dtype::INT), interpolate(";\t{0}\t{1}", enter_mnemonic, stack_size), "#" + std::to_string(stack_size));
+	this->emit(opcode::ENTER, dtype::INT, ir::Operand::value(stack_size));
 }
 
-void Emitter::end_current_subprogram(int id)
+void Emitter::set_compact(bool compact)
 {
-	auto stack_size = std::abs(symtab_ptr->get_last_addr());
+	this->printer.set_compact(compact);
+}
 
-	std::cout << *(symtab_ptr);
+void Emitter::set_annotate(bool annotate)
+{
+	this->printer.set_annotate(annotate);
+}
+
+bool Emitter::is_annotated() const
+{
+	return this->printer.is_annotated();
+}
+
+bool Emitter::is_compact() const
+{
+	return this->printer.is_compact();
+}
+
+void Emitter::set_listing(std::ostream* listing, dump_format format)
+{
+	this->listing = listing;
+	this->listing_format = format;
+}
+
+std::string_view Emitter::listing_tag() const
+{
+	if (this->listing == nullptr)
+	{
+		return "";
+	}
+
+	return this->listing_format == dump_format::JSON ? "/json" : "/table";
+}
+
+void Emitter::end_current_subprogram(int id, CachedSubprogram* record)
+{
+	//temporaries take their slots before the frame size is read; print finds them placed
+	this->slots.allocate(this->subprogram_code, this->symtab);
+	auto stack_size = this->symtab.frame_size();
+
+	if (this->listing != nullptr)
+	{
+		if (record != nullptr)
+		{
+			std::ostringstream listing;
+			this->symtab.dump(listing, this->listing_format);
+			record->listing = listing.str();
+			*this->listing << record->listing;
+		}
+		else
+		{
+			this->symtab.dump(*this->listing, this->listing_format);
+		}
+	}
 
 	this->leave_subprogram();
-	symtab_ptr->return_to_global_scope();
+
+	//the frame size is known only now, so the entry goes in front of the body
 	this->label(id);
+	auto entry = this->subprogram_code.last();
 	this->enter(stack_size);
-	this->commit_subprogram();
+	this->subprogram_code.move_to_front(entry);
+
+	this->print(this->program_code, this->output);
+
+	//the body is printed into chunks that go to the output without another copy
+	this->print(this->subprogram_code, this->body);
+	this->body_buffer.commit(this->output, record == nullptr ? nullptr : &record->code);
 
-	symtab_ptr->restore_checkpoint();
+	this->symtab.return_to_global_scope();
+	this->symtab.restore_checkpoint();
+}
+
+//Stands in for end_current_subprogram when the body was found in the cache
+//and never parsed: only the header's symbols have to be dropped again.
+void Emitter::splice_subprogram(const CachedSubprogram& cached)
+{
+	if (this->listing != nullptr)
+	{
+		*this->listing << cached.listing;
+	}
+
+	this->symtab.return_to_global_scope();
+	this->print(this->program_code, this->output);
+	this->output << cached.code;
+	this->symtab.restore_checkpoint();
+	this->symtab.set_label_counters(cached.labels);
 }
 
 void Emitter::end_program()
 {
-	if (symtab_ptr->get_scope() != scope::GLOBAL)
+	if (this->symtab.get_scope() != scope::GLOBAL)
 	{
 		throw CompilerException("Cannot emit program exit if SymTable object is not in scope::GLOBAL", lineno);
 	}
 	
-	this->emit_to_stream("\t\t", this->mnemonics.at(opcode::EXIT), ";\texit.");
-	std::cout << *symtab_ptr << std::endl;
+	this->emit(opcode::EXIT, dtype::NONE);
+	this->print(this->program_code, this->output);
+
+	if (this->listing != nullptr)
+	{
+		this->symtab.dump(*this->listing, this->listing_format);
+		if (this->listing_format == dump_format::TABLE)
+		{
+			*this->listing << std::endl;
+		}
+	}
 }
 
 void Emitter::label(int label_id)
 {
-	auto symbol = symtab_ptr->get(label_id);
+	const auto& symbol = this->symtab.get(label_id);
 	return this->label(symbol);
 }
 
-void Emitter::jump_if(Symbol& expression, Symbol& test, Symbol& where, opcode opcd)
+void Emitter::jump_if(const Symbol& expression, const Symbol& test, const Symbol& where, opcode opcd)
 {
 	if(expression.m_entry != entry::VAR and expression.m_entry != entry::NUM)
 	{
@@ -427,25 +447,108 @@ void Emitter::jump_if(Symbol& expression, Symbol& test, Symbol& where, opcode op
 		throw CompilerException(interpolate("Unknown error. Target entry is expected to be a LABEL, got {0}", where.m_entry), lineno);
 	}
 
-	auto mnemonic = this->mnemonics.at(opcd);
-	auto op = mnemonic + this->get_type_str(expression.m_dtype);
+	this->emit(opcd, expression.m_dtype, Address{expression, true}, Address{test, true}, Address{where, true});
+}
+
+void Emitter::branch(opcode op_code, const Symbol& first, const Symbol& second, const Symbol& where)
+{
+	if (first.m_entry == entry::ARR or second.m_entry == entry::ARR)
+	{
+		throw CompilerException(interpolate("No matching overload of {0} for Array type.", this->mnemonic(op_code)), lineno);
+	}
+
+	if(not ((
+			first.m_entry == entry::NUM or first.m_entry == entry::VAR
+		) and (
+			second.m_entry == entry::NUM or second.m_entry == entry::VAR
+		)
+	)) throw CompilerException(interpolate("Unknown error [branch]. Expected (NUM|VAR, NUM|VAR), got: ({0}, {1})", first.m_entry, second.m_entry), lineno);
 
-	this->emit_to_stream("\t\t", op, interpolate(";\t{0}\t{1}, {2}, {3}", mnemonic, expression.name, test.name, where.name), 
-		expression.addr_to_str(true), test.addr_to_str(true), where.addr_to_str(true));
+	if (first.m_entry == entry::NUM and second.m_entry == entry::NUM)
+	{
+		if (auto literal = folding::relation(op_code, this->constant(first), this->constant(second)))
+		{
+			if (*literal == "1")
+			{
+				this->jump(where);
+			}
+			return;
+		}
+	}
+
+	//compared the way relop compares before materializing the result
+	this->emit(op_code, dtype::INT, Address{first, true}, Address{second, true}, Address{where});
+}
+
+void Emitter::branch(int op_id, int first_id, int second_id, int where_id, bool when)
+{
+	auto op_code = when ? opcode(op_id) : this->negate_relation(opcode(op_id));
+	return this->branch(op_code, this->symtab.get(first_id), this->symtab.get(second_id), this->symtab.get(where_id));
+}
+
+void Emitter::branch_on(int value_id, int where_id, bool when)
+{
+	const auto& symbol = this->symtab.get(value_id);
+
+	if (symbol.m_entry == entry::ARR)
+	{
+		throw CompilerException("The truth value of Array type is ambigious.", lineno);
+	}
+
+	if (symbol.m_entry != entry::VAR and symbol.m_entry != entry::NUM)
+	{
+		throw CompilerException(interpolate("Unknown error [branch_on]. Expected VAR or NUM got: {0}", symbol.m_entry), lineno);
+	}
+
+	const auto& zero = this->symtab.get(this->symtab.insert_constant("0", dtype::INT));
+	this->branch(when ? opcode::NE : opcode::EQ, symbol, zero, this->symtab.get(where_id));
+}
+
+int Emitter::make_label(const std::string& prefix)
+{
+	return this->symtab.insert_label(prefix);
+}
+
+int Emitter::materialize(int false_label_id)
+{
+	const auto& temp = this->symtab.get(this->symtab.insert_temp(dtype::INT));
+	const auto& end_label = this->symtab.get(this->symtab.insert_label("endcond"));
+
+	this->assign(temp.symtab_id, this->symtab.insert_constant("1", dtype::INT));
+	this->jump(end_label);
+	this->label(false_label_id);
+	this->assign(temp.symtab_id, this->symtab.insert_constant("0", dtype::INT));
+	this->label(end_label);
+
+	return temp.symtab_id;
+}
+
+opcode Emitter::negate_relation(opcode op_code) const
+{
+	switch (op_code)
+	{
+		case opcode::EQ: return opcode::NE;
+		case opcode::NE: return opcode::EQ;
+		case opcode::LT: return opcode::GE;
+		case opcode::GE: return opcode::LT;
+		case opcode::LE: return opcode::GT;
+		case opcode::GT: return opcode::LE;
+		default: throw CompilerException(interpolate("Unknown error. Expected relational operator, got: {0}", op_code), lineno);
+	}
 }
 
 int Emitter::end_if()
 {
-	auto result = symtab_ptr->insert_label("endif");
+	auto result = this->symtab.insert_label("endif");
 	this->jump(result);
 	return result;
 }
 
 int Emitter::if_statement(int expression_id)
 {
-	auto expression = symtab_ptr->get(expression_id);
-	auto else_label = symtab_ptr->get(symtab_ptr->insert_label("else"));
-	auto zero = symtab_ptr->get(symtab_ptr->insert_constant("0", expression.m_dtype));
+	const auto& expression = this->symtab.get(expression_id);
+	const auto& else_label = this->symtab.get(this->symtab.insert_label("else"));
+	const auto& zero = this->symtab.get(this->symtab.insert_constant("0", expression.m_dtype));
 	this->jump_if(expression, zero, else_label);
 
 	return else_label.symtab_id;
@@ -453,17 +556,17 @@ int Emitter::if_statement(int expression_id)
 
 int Emitter::begin_while()
 {
-	auto while_label = symtab_ptr->get(symtab_ptr->insert_label("while"));
+	const auto& while_label = this->symtab.get(this->symtab.insert_label("while"));
 	this->label(while_label);
 	return while_label.symtab_id;
 }
 
 int Emitter::while_statement(int expression_id)
 {
-	auto expression = symtab_ptr->get(expression_id);
+	const auto& expression = this->symtab.get(expression_id);
 	
-	auto else_label = symtab_ptr->get(symtab_ptr->insert_label("endwhile"));
-	auto zero = symtab_ptr->get(symtab_ptr->insert_constant("0", expression.m_dtype));
+	const auto& else_label = this->symtab.get(this->symtab.insert_label("endwhile"));
+	const auto& zero = this->symtab.get(this->symtab.insert_constant("0", expression.m_dtype));
 
 	this->jump_if(expression, zero, else_label);
 
@@ -472,12 +575,12 @@ int Emitter::while_statement(int expression_id)
 
 std::tuple<int, int> Emitter::classic_for_statement(int variable_id, int init_value_id, int dec_or_inc, int control_value)
 {
-	auto variable = symtab_ptr->get(variable_id);
-	auto init_value = symtab_ptr->get(init_value_id);
-	auto test = symtab_ptr->get(control_value);
+	const auto& variable = this->symtab.get(variable_id);
+	const auto& init_value = this->symtab.get(init_value_id);
+	const auto& test = this->symtab.get(control_value);
 
-	auto for_label = symtab_ptr->get(symtab_ptr->insert_label("for"));
-	auto else_label = symtab_ptr->get(symtab_ptr->insert_label("endfor"));
+	const auto& for_label = this->symtab.get(this->symtab.insert_label("for"));
+	const auto& else_label = this->symtab.get(this->symtab.insert_label("endfor"));
 
 	auto opcd = static_cast<opcode>(dec_or_inc);
 
@@ -513,8 +616,8 @@ std::tuple<int, int> Emitter::classic_for_statement(int variable_id, int init_va
 void Emitter::classic_end_iteration(int variable_id, int dec_or_inc, int for_label_id)
 {
 	auto opcd = static_cast<opcode>(dec_or_inc);
-	auto variable = symtab_ptr->get(variable_id);
-	auto for_label = symtab_ptr->get(for_label_id);
+	const auto& variable = this->symtab.get(variable_id);
+	const auto& for_label = this->symtab.get(for_label_id);
 
 	if(opcd != opcode::ADD and opcd != opcode::SUB)
 	{
@@ -526,7 +629,7 @@ void Emitter::classic_end_iteration(int variable_id, int dec_or_inc, int for_lab
 		throw CompilerException(interpolate("Syntax error. Variable should be of integer type, not: {0}", variable.m_dtype), lineno);
 	}
 	
-	auto one = symtab_ptr->get(symtab_ptr->insert_constant("1", dtype::INT));
+	const auto& one = this->symtab.get(this->symtab.insert_constant("1", dtype::INT));
 
 	this->binop(opcd, variable, one, &variable);
 	this->jump(for_label);
@@ -534,62 +637,55 @@ void Emitter::classic_end_iteration(int variable_id, int dec_or_inc, int for_lab
 
 int Emitter::repeat()
 {
-	auto repeat_label = symtab_ptr->get(symtab_ptr->insert_label("repeat"));
+	const auto& repeat_label = this->symtab.get(this->symtab.insert_label("repeat"));
 	this->label(repeat_label);
 	return repeat_label.symtab_id;
 }
 
 void Emitter::until(int repeat_label_id, int expression_id)
 {
-	auto repeat_label = symtab_ptr->get(repeat_label_id);
-	auto expression = symtab_ptr->get(expression_id);
-	auto one = symtab_ptr->get(symtab_ptr->insert_constant("1", expression.m_dtype));
+	const auto& repeat_label = this->symtab.get(repeat_label_id);
+	const auto& expression = this->symtab.get(expression_id);
+	const auto& one = this->symtab.get(this->symtab.insert_constant("1", expression.m_dtype));
 
 	this->jump_if(expression, one, repeat_label);
 }
 
-void Emitter::label(Symbol& symbol)
+void Emitter::label(const Symbol& symbol)
 {
 	if (symbol.m_entry == entry::LABEL or symbol.m_entry == entry::PROC or symbol.m_entry == entry::FUNC)
 	{
-		return this->emit_to_stream(interpolate("{0}:", symbol.name), "", "");
+		this->code().append(ir::Instruction{opcode::NOP, dtype::NONE, 1, ir::Function::END, ir::Function::END, {ir::Operand{symbol.symtab_id}}});
+		return;
 	}
 
 	throw CompilerException(interpolate("Unknown error [label]. Expected LABEL, PROC or FUNC got: {0}", symbol.m_entry), lineno);
 }
 
-void Emitter::push(Symbol& symbol)
+void Emitter::push(const Symbol& symbol)
 {
 	if (symbol.m_entry != entry::VAR and symbol.m_entry != entry::ARR)
 	{
 		throw CompilerException("Unknown error", lineno);
 	}
 
-	auto opcd = opcode::PSH;
-	auto& mnemonic = this->mnemonics.at(opcd);
-	auto op = mnemonic + this->get_type_str(dtype::INT);
-
-	this->emit_to_stream("\t\t", op, interpolate(";\t{0}\t{1}", mnemonic, symbol.name), symbol.addr_to_str());
+	this->emit(opcode::PSH, dtype::INT, Address{symbol});
 }
 
 void Emitter::incsp(int num_of_bytes)
 {
-	auto opcd = opcode::INCSP;
-	auto mnemonic = this->mnemonics.at(opcd);
-	auto op = mnemonic + this->get_type_str(dtype::INT);
-
-	this->emit_to_stream("\t\t", op, interpolate(";\t{0}\t{1}", mnemonic, num_of_bytes), "#" + std::to_string(num_of_bytes));
+	this->emit(opcode::INCSP, dtype::INT, ir::Operand::value(num_of_bytes));
 }
 
-void Emitter::check_arrays(Symbol& arr1, Symbol& arr2)
+void Emitter::check_arrays(const Symbol& arr1, const Symbol& arr2)
 {
 	if (arr1.m_entry != entry::ARR or arr2.m_entry != entry::ARR)
 	{
 		throw CompilerException("Unknown exception, one of variables is not array", lineno);
 	}
 
-	auto& dims1 = arr1.args[0].args;
-	auto& dims2 = arr2.args[0].args;
+	const auto& dims1 = this->symtab.array_type(arr1).dims;
+	const auto& dims2 = this->symtab.array_type(arr2).dims;
 
 	if(dims1.size() != dims2.size())
 	{
@@ -598,10 +694,10 @@ void Emitter::check_arrays(Symbol& arr1, Symbol& arr2)
 
 	for (auto i = 0ull; i < dims1.size(); ++i)
 	{
-		auto dim1 = dims1[i];
-		auto dim2 = dims2[i];
-		int val1 = std::abs(dim1.stop_ind - dim1.start_ind + 1);
-		int val2 = std::abs(dim2.stop_ind - dim2.start_ind + 1);
+		const auto& dim1 = dims1[i];
+		const auto& dim2 = dims2[i];
+		int val1 = dim1.length();
+		int val2 = dim2.length();
 
 		if(val2 != val1)
 		{
@@ -612,10 +708,10 @@ void Emitter::check_arrays(Symbol& arr1, Symbol& arr2)
 
 std::optional<int> Emitter::make_call(int proc_or_fun, bool result_required)
 {
-	auto args = this->params;
-	auto proc_or_fun_sym = symtab_ptr->get(proc_or_fun);
+	const auto& args = this->params;
+	const auto& proc_or_fun_sym = this->symtab.get(proc_or_fun);
 
-	const auto& entry_descriptor = [](entry& e){
+	const auto& entry_descriptor = [](const entry& e){
 		switch(e)
 		{
             case entry::VAR: return std::string("Scalar variable");
@@ -626,25 +722,25 @@ std::optional<int> Emitter::make_call(int proc_or_fun, bool result_required)
 
 	if(proc_or_fun_sym.m_entry != entry::PROC and proc_or_fun_sym.m_entry != entry::FUNC)
 	{
-		throw CompilerException(interpolate("Syntax error. {0} is not callable", proc_or_fun_sym.name), lineno);
+		throw CompilerException(interpolate("Syntax error. {0} is not callable", this->symtab.name(proc_or_fun_sym)), lineno);
 	}
 
-	auto& signature = proc_or_fun_sym.args;
+	const int arity = this->symtab.arity(proc_or_fun_sym);
 
-	if (signature.size() != args.size())
+	if (arity != static_cast<int>(args.size()))
 	{
-		throw CompilerException(interpolate("Syntax error. Callable {0} expects {1} parameter, got {2}", proc_or_fun_sym.name, signature.size(), args.size()), lineno);
+		throw CompilerException(interpolate("Syntax error. Callable {0} expects {1} parameter, got {2}", this->symtab.name(proc_or_fun_sym), arity, args.size()), lineno);
 	}
 
 	if(result_required and proc_or_fun_sym.m_entry == entry::PROC)
 	{
-		throw CompilerException(interpolate("Syntax error. {0} is not a function", proc_or_fun_sym.name), lineno);
+		throw CompilerException(interpolate("Syntax error. {0} is not a function", this->symtab.name(proc_or_fun_sym)), lineno);
 	}
 
-	for (int i = signature.size() -1; i >= 0; --i)
+	for (int i = arity -1; i >= 0; --i)
 	{
-		auto sig_symbol = signature[i];
-		auto arg_symbol = symtab_ptr->get(args[i]);
+		const auto& sig_symbol = this->symtab.parameter(proc_or_fun_sym, i);
+		const auto& arg_symbol = this->symtab.get(args[i]);
 		
 		if (arg_symbol.m_entry != entry::NUM and arg_symbol.m_entry != sig_symbol.m_entry)
 		{
@@ -679,7 +775,7 @@ std::optional<int> Emitter::make_call(int proc_or_fun, bool result_required)
 
 			auto array_ref = arg_symbol.m_entry == entry::ARR;
 
-			auto temp = symtab_ptr->get(symtab_ptr->insert_temp(arg_symbol.m_dtype, array_ref));
+			const auto& temp = this->symtab.get(this->symtab.insert_temp(arg_symbol.m_dtype, array_ref));
 
 			this->assign(temp, arg_symbol);
 			this->push(temp);
@@ -690,14 +786,11 @@ std::optional<int> Emitter::make_call(int proc_or_fun, bool result_required)
 
 	if (proc_or_fun_sym.m_entry == entry::FUNC)
 	{
-		auto res_sym = symtab_ptr->get(symtab_ptr->insert_temp(proc_or_fun_sym.m_dtype));
+		const auto& res_sym = this->symtab.get(this->symtab.insert_temp(proc_or_fun_sym.m_dtype));
 		result = res_sym.symtab_id;
 		this->push(res_sym);
 	}
 
-	auto opcd = opcode::CALL;
-	auto mnemonic = this->mnemonics.at(opcd);
-	auto op = mnemonic + this->get_type_str(dtype::INT);
 	auto sz = static_cast<int>(varsize::REF) * args.size();
 
 	if (proc_or_fun_sym.m_entry == entry::FUNC)
@@ -705,7 +798,7 @@ std::optional<int> Emitter::make_call(int proc_or_fun, bool result_required)
 		sz += static_cast<int>(varsize::REF);
 	}
 
-	this->emit_to_stream("\t\t", op, interpolate(";\t{0}\t{1}", mnemonic, proc_or_fun_sym.name), proc_or_fun_sym.addr_to_str(false, true));
+	this->emit(opcode::CALL, dtype::INT, Address{proc_or_fun_sym, false, true});
 	this->incsp(sz);
 
 	if (result == SymTable::NONE)
@@ -718,65 +811,9 @@ std::optional<int> Emitter::make_call(int proc_or_fun, bool result_required)
 	}
 }
 
-int Emitter::left_eval_and_or(int lval_label, int rval, bool or_op)
-{
-	auto eval_lval_only = symtab_ptr->get(lval_label);
-
-	if (eval_lval_only.m_entry != entry::LABEL)
-	{
-		throw CompilerException(interpolate("Unknown error [left_eval_and_or]. Expected entry::LABEL, got {0}", eval_lval_only.m_entry), lineno);
-	}
-
-	auto symbol = symtab_ptr->get(rval);
-
-	if (symbol.m_entry == entry::ARR)
-	{
-		throw CompilerException("The truth value of Array type is ambigious.", lineno);
-	}
-
-	if (symbol.m_entry != entry::VAR and symbol.m_entry != entry::NUM)
-	{
-		throw CompilerException(interpolate("Unknown error [left_eval_and_or]. Expected VAR or NUM got: {0}", symbol.m_entry), lineno);
-	}
-
-	auto temp_lval = symtab_ptr->get(symtab_ptr->insert_temp(dtype::INT));
-	auto temp_rval = symtab_ptr->get(symtab_ptr->insert_temp(dtype::INT));
-
-	auto op_symbol = opcode::NE;
-	auto eval_op_symbol = or_op? opcode::OR : opcode::AND;
-	auto zero = symtab_ptr->get(symtab_ptr->insert_constant("0", dtype::INT));
-	auto one = symtab_ptr->get(symtab_ptr->insert_constant("1", dtype::INT));
-
-	auto relop_result = symtab_ptr->get(this->relop(op_symbol, zero, symbol));
-	auto rest_of_code = symtab_ptr->get(symtab_ptr->insert_label(interpolate("{0}result", this->mnemonics.at(eval_op_symbol))));
-
-	auto r_enabler = or_op ? zero : one;
-	auto r_disabler = or_op ? one : zero;
-
-	this->assign(temp_lval, r_enabler);
-	this->assign(temp_rval, relop_result);
-	this->jump(rest_of_code);
-	this->label(eval_lval_only);
-	this->assign(temp_rval, zero);
-	this->assign(temp_lval, r_disabler);
-	this->label(rest_of_code);
-
-	return this->andorop(eval_op_symbol, temp_lval, temp_rval);
-}
-
-int Emitter::and_then(int lval_label, int rval)
+int Emitter::andorop(opcode opcd, const Symbol& first, const Symbol& second, const Symbol* result)
 {
-	return this->left_eval_and_or(lval_label, rval, false);
-}
-
-int Emitter::or_else(int lval_label, int rval)
-{
-	return this->left_eval_and_or(lval_label, rval, true);
-}
-
-int Emitter::andorop(opcode opcd, Symbol& first, Symbol& second, Symbol* result)
-{
-	auto mnemonic = this->mnemonics.at(opcd);
+	auto mnemonic = this->mnemonic(opcd);
 
 	if (opcd != opcode::OR and opcd != opcode::AND)
 	{
@@ -784,38 +821,25 @@ int Emitter::andorop(opcode opcd, Symbol& first, Symbol& second, Symbol* result)
 	}
 
 	auto type = dtype::INT;
-	auto temp = result == nullptr ? symtab_ptr->get(symtab_ptr->insert_temp(type)) : *result;
-
-	if (type != first.m_dtype)
-	{
-		first = symtab_ptr->get(this->cast(first, type));
-	}
+	const auto& temp = result == nullptr ? this->symtab.get(this->symtab.insert_temp(type)) : *result;
 
-	if (type != second.m_dtype)
-	{
-		second = symtab_ptr->get(this->cast(second, type));
-	}
+	const auto& lhs = type != first.m_dtype ? this->symtab.get(this->cast(first, type)) : first;
+	const auto& rhs = type != second.m_dtype ? this->symtab.get(this->cast(second, type)) : second;
 
-	auto op = mnemonic + this->get_type_str(type);
-
-	this->emit_to_stream("\t\t", op, interpolate(";\t{0}\t{1}, {2}, {3}", mnemonic, first.name, second.name, temp.name), 
-						 first.addr_to_str(true), second.addr_to_str(true), temp.addr_to_str(true));
+	this->emit(opcd, type, Address{lhs, true}, Address{rhs, true}, Address{temp, true});
 
 	return temp.symtab_id;
 }
 
 void Emitter::write(int symbol_id)
 {
-	auto symbol = symtab_ptr->get(symbol_id);
-	auto& mnemonic = this->mnemonics.at(opcode::WRT);
-	
+	const auto& symbol = this->symtab.get(symbol_id);
 	switch (symbol.m_entry)
 	{		
         case entry::VAR:
         case entry::NUM:
 		{
-			std::string op = mnemonic + this->get_type_str(symbol.m_dtype);
-			this->emit_to_stream("\t\t", op, interpolate(";\t{0}\t{1}", mnemonic, symbol.name), symbol.addr_to_str(true));
+			this->emit(opcode::WRT, symbol.m_dtype, Address{symbol, true});
 			break;
 		}
 		
@@ -830,18 +854,16 @@ void Emitter::write(int symbol_id)
 
 void Emitter::read(int symbol_id)
 {
-	auto symbol = symtab_ptr->get(symbol_id);
-	auto& mnemonic = this->mnemonics.at(opcode::RD);
+	const auto& symbol = this->symtab.get(symbol_id);
 	switch (symbol.m_entry)
 	{		
         case entry::VAR:
 		{
-			std::string op = mnemonic + this->get_type_str(symbol.m_dtype);
-			this->emit_to_stream("\t\t", op, interpolate(";\t{0}\t{1}", mnemonic, symbol.name), symbol.addr_to_str(true));
+			this->emit(opcode::RD, symbol.m_dtype, Address{symbol, true});
 			break;
 		}
         case entry::NUM:
-			throw CompilerException(interpolate("Syntax error, expected variable identifier, got an constant: {0}, of {1}", symbol.name, symbol.type_to_str()), lineno);
+			throw CompilerException(interpolate("Syntax error, expected variable identifier, got an constant: {0}, of {1}", this->symtab.name(symbol), this->symtab.type_to_str(symbol)), lineno);
         case entry::ARR:
 			throw CompilerException("No matching overload of read procedure for Array type", lineno);
 		case entry::RNG:
@@ -851,7 +873,7 @@ void Emitter::read(int symbol_id)
     }
 }
 
-void Emitter::assign(Symbol& lval_sym, Symbol& rval_sym)
+void Emitter::assign(const Symbol& lval_sym, const Symbol& rval_sym)
 {
 	if (rval_sym.m_entry == entry::ARR and lval_sym.m_entry == entry::VAR)
 	{
@@ -874,45 +896,36 @@ void Emitter::assign(Symbol& lval_sym, Symbol& rval_sym)
 		return this->move_pointer(rval_sym, lval_sym);
 	}
 
-	if (lval_sym.m_dtype != rval_sym.m_dtype)
-	{
-		rval_sym = symtab_ptr->get(this->cast(rval_sym, lval_sym.m_dtype));
-	}
-
-	auto mnemonic = this->mnemonics.at(opcode::MOV);
-	auto op = mnemonic + this->get_type_str(lval_sym.m_dtype);
+	const auto& value = lval_sym.m_dtype != rval_sym.m_dtype ? this->symtab.get(this->cast(rval_sym, lval_sym.m_dtype)) : rval_sym;
 
-	this->emit_to_stream("\t\t", op, interpolate(";\t{0}\t{1}, {2}", mnemonic, rval_sym.name, lval_sym.name), rval_sym.addr_to_str(true), lval_sym.addr_to_str(true));
+	this->emit(opcode::MOV, lval_sym.m_dtype, Address{value, true}, Address{lval_sym, true});
 }
 
 void Emitter::assign(int lval, int rval)
 {
-	auto lval_sym = symtab_ptr->get(lval);
-	auto rval_sym = symtab_ptr->get(rval);
+	const auto& lval_sym = this->symtab.get(lval);
+	const auto& rval_sym = this->symtab.get(rval);
 
 	return this->assign(lval_sym, rval_sym);
 }
 
 void Emitter::jump(int where)
 {
-	auto label = symtab_ptr->get(where);
+	const auto& label = this->symtab.get(where);
 	return this->jump(label);
 }
 
-void Emitter::jump(Symbol& label)
+void Emitter::jump(const Symbol& label)
 {
 	if (label.m_entry != entry::LABEL and label.m_entry != entry::FUNC and label.m_entry != entry::PROC)
 	{
 		throw CompilerException(interpolate("Unknown error [jump]. Expected LABEL, PROC or FUNC, got: {0}", label.m_entry), lineno);
 	}
 
-	auto& mnemonic = this->mnemonics.at(opcode::JMP);
-	auto op = mnemonic + ".i";
-
-	this->emit_to_stream("\t\t", op, interpolate(";\t{0}\t{1}", mnemonic, label.name), label.addr_to_str());
+	this->emit(opcode::JMP, dtype::INT, Address{label});
 }
 
-int Emitter::relop(opcode op_code, Symbol& first, Symbol& second, Symbol* result)
+int Emitter::relop(opcode op_code, const Symbol& first, const Symbol& second, const Symbol* result)
 {
 	if(not ((
 			first.m_entry == entry::NUM or first.m_entry == entry::VAR
@@ -921,29 +934,35 @@ int Emitter::relop(opcode op_code, Symbol& first, Symbol& second, Symbol* result
 		)
 	)) throw CompilerException(interpolate("Unknown error [relop]. Expected (NUM|VAR, NUM|VAR), got: ({0}, {1})", first.m_entry, second.m_entry), lineno);
 
+	if (result == nullptr and first.m_entry == entry::NUM and second.m_entry == entry::NUM)
+	{
+		if (auto literal = folding::relation(op_code, this->constant(first), this->constant(second)))
+		{
+			return this->symtab.insert_constant(*literal, dtype::INT);
+		}
+	}
+
 	auto op_type = dtype::INT;
 	auto type = dtype::INT;
-	auto temp = result == nullptr ? symtab_ptr->get(symtab_ptr->insert_temp(type)) : *result;
-	auto mnemonic = this->mnemonics.at(op_code);
-	auto op = mnemonic + this->get_type_str(op_type);
+	const auto& temp = result == nullptr ? this->symtab.get(this->symtab.insert_temp(type)) : *result;
+	auto mnemonic = this->mnemonic(op_code);
 
-	auto true_label = symtab_ptr->get(symtab_ptr->insert_label(mnemonic + "true"));
-	auto false_label = symtab_ptr->get(symtab_ptr->insert_label(mnemonic + "false"));
+	const auto& true_label = this->symtab.get(this->symtab.insert_label(std::string(mnemonic).append("true")));
+	const auto& false_label = this->symtab.get(this->symtab.insert_label(std::string(mnemonic).append("false")));
 	
-	this->emit_to_stream("\t\t", op, interpolate(";\t{0}\t{1}, {2}, {3}", mnemonic, first.name, second.name, true_label.name),
-						 first.addr_to_str(true), second.addr_to_str(true), true_label.addr_to_str());
+	this->emit(op_code, op_type, Address{first, true}, Address{second, true}, Address{true_label});
 
 	
-	this->assign(temp.symtab_id, symtab_ptr->insert_constant("0", type));
+	this->assign(temp.symtab_id, this->symtab.insert_constant("0", type));
 	this->jump(false_label.symtab_id);
 	this->label(true_label.symtab_id);
-	this->assign(temp.symtab_id, symtab_ptr->insert_constant("1", type));
+	this->assign(temp.symtab_id, this->symtab.insert_constant("1", type));
 	this->label(false_label.symtab_id);
 
 	return temp.symtab_id;
 }
 
-int Emitter::binop(opcode op_code, Symbol& first, Symbol& second, Symbol* result)
+int Emitter::binop(opcode op_code, const Symbol& first, const Symbol& second, const Symbol* result)
 {
 	if(not ((
 			first.m_entry == entry::NUM or first.m_entry == entry::VAR
@@ -952,38 +971,36 @@ int Emitter::binop(opcode op_code, Symbol& first, Symbol& second, Symbol* result
 		)
 	)) throw CompilerException(interpolate("Unknown error [binop]. Expected (NUM|VAR, NUM|VAR), got: ({0}, {1})", first.m_entry, second.m_entry), lineno);
 
-	auto type = symtab_ptr->infer_type(first, second);
-	
-	if (type != first.m_dtype)
-	{
-		first = symtab_ptr->get(this->cast(first, type));
-	}
+	auto type = this->symtab.infer_type(first, second);
 
-	if (type != second.m_dtype)
+	if (result == nullptr and first.m_entry == entry::NUM and second.m_entry == entry::NUM)
 	{
-		second = symtab_ptr->get(this->cast(second, type));
+		if (auto literal = folding::binary(op_code, type, this->constant(first), this->constant(second)))
+		{
+			return this->symtab.insert_constant(*literal, type);
+		}
 	}
 	
-	auto temp = result == nullptr ? symtab_ptr->get(symtab_ptr->insert_temp(type)) : *result;
-	auto& mnemonic = this->mnemonics.at(op_code);
-	auto op = mnemonic + this->get_type_str(type);
+	const auto& lhs = type != first.m_dtype ? this->symtab.get(this->cast(first, type)) : first;
+	const auto& rhs = type != second.m_dtype ? this->symtab.get(this->cast(second, type)) : second;
+	
+	const auto& temp = result == nullptr ? this->symtab.get(this->symtab.insert_temp(type)) : *result;
 
-	this->emit_to_stream("\t\t", op, interpolate(";\t{0}\t{1}, {2}, {3}", mnemonic, first.name, second.name, temp.name), 
-						 first.addr_to_str(true), second.addr_to_str(true), temp.addr_to_str(true));
+	this->emit(op_code, type, Address{lhs, true}, Address{rhs, true}, Address{temp, true});
 
 	return temp.symtab_id;
 }
 
 int Emitter::binary_op(int op_id, int operand1, int operand2)
 {	
-	auto first = symtab_ptr->get(operand1);
-	auto second = symtab_ptr->get(operand2);
+	const auto& first = this->symtab.get(operand1);
+	const auto& second = this->symtab.get(operand2);
 
 	auto op_code = opcode(op_id);
 
 	if (first.m_entry == entry::ARR or second.m_entry == entry::ARR)
 	{
-		throw CompilerException(interpolate("No matching overload of {0} for Array type.", this->mnemonics.at(op_code)), lineno);
+		throw CompilerException(interpolate("No matching overload of {0} for Array type.", this->mnemonic(op_code)), lineno);
 	}
 
 	switch (op_code) 
@@ -1008,7 +1025,7 @@ int Emitter::binary_op(int op_id, int operand1, int operand2)
 	}
 }
 
-int Emitter::cast(Symbol& symbol, dtype& to)
+int Emitter::cast(const Symbol& symbol, const dtype& to)
 {
 	if (symbol.m_entry == entry::ARR)
 	{
@@ -1043,63 +1060,35 @@ int Emitter::cast(Symbol& symbol, dtype& to)
 	{
 		throw CompilerException(interpolate("Unknown error [cast]. {0}", opcd), lineno);
 	}
+
+	if (symbol.m_entry == entry::NUM)
+	{
+		if (auto literal = folding::cast(this->constant(symbol), to))
+		{
+			return this->symtab.insert_constant(*literal, to);
+		}
+	}
 	
-	auto return_id = symtab_ptr->insert_temp(to);
-	auto temp = symtab_ptr->get(return_id);
-	auto& mnemonic = this->mnemonics.at(opcd);
-	auto op = mnemonic + this->get_type_str(symbol.m_dtype);
+	auto return_id = this->symtab.insert_temp(to);
+	const auto& temp = this->symtab.get(return_id);
 
-	this->emit_to_stream("\t\t", op, interpolate(";\t{0}\t{1}, {2}", op, symbol.name, temp.name), symbol.addr_to_str(true), temp.addr_to_str(true));
+	this->emit(opcd, symbol.m_dtype, Address{symbol, true}, Address{temp, true});
 
 	return return_id;
 }
 
-int Emitter::cast(int id, dtype& to)
-{
-	auto sym = symtab_ptr->get(id);
-	return this->cast(sym, to);
-}
-
-std::ostream& Emitter::get_stream()
+folding::Constant Emitter::constant(const Symbol& symbol)
 {
-	return symtab_ptr->get_scope() == scope::GLOBAL ? this->output : this->mem;
+	return folding::Constant{symbol.m_dtype, this->symtab.name(symbol)};
 }
 
-int Emitter::begin_left_eval_or_and(opcode opcd, int lval)
+int Emitter::cast(int id, const dtype& to)
 {
-	if (opcd != opcode::EQ and opcd != opcode::NE)
-	{
-		throw CompilerException(interpolate("Unknown error [begin_left_eval_only]. Expected EQ or NE got: {0}", opcd), lineno);
-	}
-
-	auto& symbol = symtab_ptr->get(lval);
-
-	if (symbol.m_entry == entry::ARR)
-	{
-		throw CompilerException("The truth value of Array type is ambigious.", lineno);
-	}
-
-	if (symbol.m_entry != entry::VAR and symbol.m_entry != entry::NUM)
-	{
-		throw CompilerException(interpolate("Unknown error [begin_left_eval_only]. Expected VAR or NUM got: {0}", symbol.m_entry), lineno);
-	}
-
-	auto eval_left_only = symtab_ptr->get(symtab_ptr->insert_label("leftonly"));
-
-	auto& mnemonic = this->mnemonics.at(opcd);
-	auto op = mnemonic + this->get_type_str(dtype::INT);
-
-	this->emit_to_stream("\t\t", op, interpolate(";\t{0}\t{1}, 0, {2}", mnemonic, symbol.name, eval_left_only.name), symbol.addr_to_str(true), std::string("#0"), eval_left_only.addr_to_str());
-
-	return eval_left_only.symtab_id;
+	const auto& sym = this->symtab.get(id);
+	return this->cast(sym, to);
 }
 
-int Emitter::begin_or_else(int lval)
+ir::Function& Emitter::code()
 {
-	return this->begin_left_eval_or_and(opcode::NE, lval);
+	return this->symtab.get_scope() == scope::GLOBAL ? this->program_code : this->subprogram_code;
 }
-
-int Emitter::begin_and_then(int lval)
-{
-	return this->begin_left_eval_or_and(opcode::EQ, lval);
-}
\ No newline at end of file
@@ -1,4 +1,10 @@
 #include "symtable.hpp"
+#include "subprogramcache.hpp"
+#include "ir.hpp"
+#include "printer.hpp"
+#include "folding.hpp"
+#include "slotallocator.hpp"
+#include "chunkbuffer.hpp"
 #include <cmath>
 #include <optional>
 #include <stack>
@@ -7,54 +13,86 @@
 #include <iostream>
 #include <map>
 #include <vector>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 #include <algorithm>
 
-extern int lineno;
-extern std::shared_ptr<SymTable> symtab_ptr;
+//Symbol operand of an instruction, see ir::Operand.
+struct Address
+{
+	const Symbol& symbol;
+	bool dereference = false;
+	bool callable = false;
+};
 
 class Emitter
 {		
 	private:
-		const static std::map<opcode, std::string> mnemonics;
 		std::ostream &output;
-		std::stringstream mem;
-		std::stringstream temp_mem;
-		std::string get_type_str(const dtype&);
+		SymTable& symtab;
+		const int& lineno; //line counter of the owning compilation, for diagnostics
+		std::ostream* listing = nullptr; //symtab dumps, opt-in; nothing is formatted while null
+		dump_format listing_format = dump_format::TABLE;
+		ir::Function program_code; //global scope code not printed yet
+		ir::Function subprogram_code; //body of the subprogram being compiled, printed once its frame size is known
+		Printer printer{this->symtab};
+		SlotAllocator slots;
+		ChunkBuffer body_buffer; //printed subprogram, spliced into the output
+		std::ostream body{&this->body_buffer};
+		std::string_view mnemonic(opcode) const;
 		std::stack<std::vector<int>> params_stack;
 		std::vector<int> params;
 
-		void push(Symbol&);
-		int reduce(Symbol&, std::vector<Symbol>&);
-		void check_arrays(Symbol&, Symbol&);
-		void check_bounds(Symbol&, Symbol&);
-		int cast(Symbol&, dtype&);
-		int negate(Symbol&);
-		int boolean_negate(Symbol&);
-		int binop(opcode, Symbol&, Symbol&, Symbol* result = nullptr);
-		int relop(opcode, Symbol&, Symbol&, Symbol* result = nullptr);
-		int andorop(opcode, Symbol&, Symbol&, Symbol* result = nullptr);
-		int shift_pointer(Symbol&, Symbol&, Symbol* result = nullptr);
-		void move_pointer(Symbol&, Symbol&);
-		int begin_left_eval_or_and(opcode, int);
-		int left_eval_and_or(int, int, bool or_op=false);
+		void push(const Symbol&);
+		int reduce(const Symbol&, const std::vector<int>&);
+		void check_arrays(const Symbol&, const Symbol&);
+		void check_bounds(const Symbol&, const Bounds&);
+		int cast(const Symbol&, const dtype&);
+		folding::Constant constant(const Symbol&); //NUM symbol as seen by folding, valid while the symbol lives
+		int negate(const Symbol&);
+		int boolean_negate(const Symbol&);
+		int binop(opcode, const Symbol&, const Symbol&, const Symbol* result = nullptr);
+		int relop(opcode, const Symbol&, const Symbol&, const Symbol* result = nullptr);
+		int andorop(opcode, const Symbol&, const Symbol&, const Symbol* result = nullptr);
+		int shift_pointer(const Symbol&, const Symbol&, const Symbol* result = nullptr);
+		void move_pointer(const Symbol&, const Symbol&);
 		void read(int);
 		void write(int);
 		void incsp(int);
-		void assign(Symbol&, Symbol&);
-		void label(Symbol&);
-		void jump(Symbol&);
-		void jump_if(Symbol&, Symbol&, Symbol&, opcode=opcode::EQ);
+		void assign(const Symbol&, const Symbol&);
+		void label(const Symbol&);
+		void jump(const Symbol&);
+		void jump_if(const Symbol&, const Symbol&, const Symbol&, opcode=opcode::EQ);
+		void branch(opcode, const Symbol&, const Symbol&, const Symbol&); //jumps when the relation holds, without a 0/1 temp
+		opcode negate_relation(opcode) const;
 		void enter(int);
 
 		void leave_subprogram();
-		void commit_subprogram();
+		void print(ir::Function&, std::ostream&); //places its temporaries, prints and empties the function
+
+		ir::Function& code(); //where instructions go in the current scope
+
+		static ir::Operand operand(const Address& address)
+		{
+			return ir::Operand{address.symbol.symtab_id, address.dereference, address.callable};
+		}
+
+		static ir::Operand operand(const ir::Operand& operand)
+		{
+			return operand;
+		}
+
+		template<typename... Operands>
+		void emit(opcode op, dtype type, const Operands&... operands)
+		{
+			static_assert(sizeof...(Operands) <= 3, "three-address code");
+			this->code().append(ir::Instruction{op, type, sizeof...(Operands), ir::Function::END, ir::Function::END, {Emitter::operand(operands)...}});
+		}
 
 	public:
-		Emitter();
-		Emitter(std::ostream &output): output(output) {};
-		Emitter(const Emitter& e): output(e.output) {};
+		Emitter(std::ostream &output, SymTable& symtab, const int& lineno): output(output), symtab(symtab), lineno(lineno) {};
+		Emitter(const Emitter&) = delete;
 
 		std::vector<int> get_params();
 		void clear_params();
@@ -63,15 +101,22 @@ class Emitter
 		void store_param(int);
 		void store_param_on_stack(int);
 
-		void end_current_subprogram(int);
+		void set_listing(std::ostream*, dump_format = dump_format::TABLE);
+		std::string_view listing_tag() const; //"" without a listing, else names its format
+		void set_compact(bool); //unaligned instructions, see Formatter
+		bool is_compact() const;
+		void set_annotate(bool); //comments are on by default
+		bool is_annotated() const;
+		void end_current_subprogram(int, CachedSubprogram* record = nullptr); //record receives the code and listing as written
+		void splice_subprogram(const CachedSubprogram&);
 
 		int binary_op(int, int, int);
 		int unary_op(int, int);
-		int begin_or_else(int);
-		int begin_and_then(int);
-		int and_then(int, int);
-		int or_else(int, int);
 		int get_item(int);
+		int make_label(const std::string&); //placed later with label()
+		void branch(int, int, int, int, bool when = true); //jumps when the relation of the operands is as given
+		void branch_on(int, int, bool when = true); //jumps when the truth of the value is as given, nonzero being true
+		int materialize(int); //0 or 1 of a condition that jumped to the given label when false
 		int variable_or_call(int, bool=false);
 		void jump(int);
 		void assign(int, int);
@@ -80,7 +125,7 @@ class Emitter
 		void start_program(int);
 		void end_program();
 		void label(int);
-		int cast(int, dtype&);
+		int cast(int, const dtype&);
 		int if_statement(int);
 		int end_if();
 		int begin_while();
@@ -92,7 +137,7 @@ class Emitter
 
 		void write()
 		{
-			auto data = this->params;
+			const auto& data = this->params;
 			if(data.empty()) throw CompilerException("Syntax error. Write procedure expects at least one argument.", lineno);
 			std::for_each(data.cbegin(), data.cend(), [this](auto symbol_id){this->write(symbol_id);});
 		}
@@ -105,7 +150,7 @@ class Emitter
 
 		void read()
 		{
-			auto data = this->params;
+			const auto& data = this->params;
 			if(data.empty()) throw CompilerException("Syntax error. Read procedure expects at least one argument.", lineno);
 			std::for_each(data.cbegin(), data.cend(), [this](auto symbol_id){this->read(symbol_id);});
 		}
@@ -115,40 +160,4 @@ class Emitter
 		{
 			(read(symbol_ids), ...);
 		}
-
-		template<typename... Str, typename=std::enable_if_t<std::conjunction_v<std::is_same<std::string, Str>...>>>
-		void emit_to_stream(const std::string& label, const std::string& op, const std::string& comment, const Str&... mnemonics)
-		{
-			auto& stream = this->get_stream();
-
-  			stream << std::endl << std::setw(8) << std::left;
-			int max_mnemonics = 3;
-  			const auto& print = [&stream, &max_mnemonics](const std::string& item)
-			{
-				if (max_mnemonics-- < 3)
-					stream << ",";
-     			stream << std::setw(12) << item ;
-  			};
-
-  			stream << label<< std::setw(16);
-  			stream << op << std::setw(0) << std::right;
-  			(print(mnemonics), ...);
-
-			for(auto i =0; i < max_mnemonics; ++i)
-			{
-				stream << std::setw(not i ? 12: 13) << "";
-			}
-
-			if(not comment.empty())
-			{
-				stream << std::setw(16) << "\t" << std::left;
-				stream << comment << std::setw(0);
-			}
-			else
-			{
-				stream << std::setw(0) << std::left;
-			}
-		}
-
-		std::ostream& get_stream();
 };
\ No newline at end of file
@@ -1,6 +1,8 @@
+#pragma once
+#include <cstdint>
 #include <ostream>
 
-enum class scope 
+enum class scope: std::uint8_t
 {
 	UNBOUND,
 	GLOBAL,
@@ -61,7 +63,7 @@ inline std::ostream& operator<<(std::ostream& out, const local_scope lsc)
 	return out;
 }
 
-enum class dtype
+enum class dtype: std::uint8_t
 {
 	NONE,
 	INT,
@@ -98,7 +100,7 @@ inline std::ostream& operator<<(std::ostream& out, const dtype t)
 	return out;
 }
 
-enum class entry
+enum class entry: std::uint8_t
 {
 	NONE,
 	FUNC,
@@ -206,7 +208,8 @@ enum token
     CONST_REAL,
 	REAL_FRAG,
     NONE,
-    DONE
+    DONE,
+    CACHED
 };
 
 
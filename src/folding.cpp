@@ -0,0 +1,178 @@
+#include "folding.hpp"
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+namespace
+{
+	struct Value
+	{
+		dtype type;
+		std::int64_t integer = 0;
+		double real = 0.0;
+	};
+
+	//integers of the machine are 32 bit wide, wider results are left to run time
+	bool fits(std::int64_t value)
+	{
+		return value >= std::numeric_limits<std::int32_t>::min() and value <= std::numeric_limits<std::int32_t>::max();
+	}
+
+	std::optional<Value> parse(const folding::Constant& constant)
+	{
+		auto first = constant.literal.data();
+		auto last = first + constant.literal.size();
+		Value value{constant.type};
+
+		switch (constant.type)
+		{
+			case dtype::INT:
+			{
+				auto [end, error] = std::from_chars(first, last, value.integer);
+				if (error != std::errc() or end != last or not fits(value.integer)) return std::nullopt;
+				return value;
+			}
+			case dtype::REAL:
+			{
+				auto [end, error] = std::from_chars(first, last, value.real);
+				if (error != std::errc() or end != last or not std::isfinite(value.real)) return std::nullopt;
+				return value;
+			}
+			default:
+				return std::nullopt;
+		}
+	}
+
+	std::optional<std::string> spell(std::int64_t value)
+	{
+		if (not fits(value)) return std::nullopt;
+		return std::to_string(value);
+	}
+
+	//Shortest digits that read back as the same double, always with a point:
+	//constants are pooled by spelling, so a real must never look like an integer.
+	std::optional<std::string> spell(double value)
+	{
+		if (not std::isfinite(value)) return std::nullopt;
+
+		char digits[std::numeric_limits<double>::max_exponent10 + std::numeric_limits<double>::max_digits10 + 8];
+		auto [end, error] = std::to_chars(digits, digits + sizeof(digits), value, std::chars_format::fixed);
+		if (error != std::errc()) return std::nullopt;
+
+		std::string literal(digits, end);
+		if (literal.find('.') == std::string::npos)
+		{
+			literal.append(".0");
+		}
+		return literal;
+	}
+
+	std::optional<Value> promote(std::optional<Value> value, dtype to)
+	{
+		if (not value or value->type == to) return value;
+		if (value->type != dtype::INT or to != dtype::REAL) return std::nullopt;
+
+		value->type = dtype::REAL;
+		value->real = static_cast<double>(value->integer);
+		return value;
+	}
+
+	std::optional<std::string> integer_binary(opcode op, std::int64_t lhs, std::int64_t rhs)
+	{
+		switch (op)
+		{
+			case opcode::ADD: return spell(lhs + rhs);
+			case opcode::SUB: return spell(lhs - rhs);
+			case opcode::MUL: return spell(lhs * rhs);
+			//div and mod truncate toward zero, like the instructions they replace
+			case opcode::DIV: return rhs == 0 ? std::nullopt : spell(lhs / rhs);
+			case opcode::MOD: return rhs == 0 ? std::nullopt : spell(lhs % rhs);
+			default: return std::nullopt;
+		}
+	}
+
+	std::optional<std::string> real_binary(opcode op, double lhs, double rhs)
+	{
+		switch (op)
+		{
+			case opcode::ADD: return spell(lhs + rhs);
+			case opcode::SUB: return spell(lhs - rhs);
+			case opcode::MUL: return spell(lhs * rhs);
+			case opcode::DIV: return rhs == 0.0 ? std::nullopt : spell(lhs / rhs);
+			default: return std::nullopt;
+		}
+	}
+}
+
+namespace folding
+{
+	std::optional<std::string> binary(opcode op, dtype type, const Constant& first, const Constant& second)
+	{
+		auto lhs = promote(parse(first), type);
+		auto rhs = promote(parse(second), type);
+		if (not lhs or not rhs) return std::nullopt;
+
+		switch (type)
+		{
+			case dtype::INT: return integer_binary(op, lhs->integer, rhs->integer);
+			case dtype::REAL: return real_binary(op, lhs->real, rhs->real);
+			default: return std::nullopt;
+		}
+	}
+
+	std::optional<std::string> relation(opcode op, const Constant& first, const Constant& second)
+	{
+		//relations are always emitted as integer comparisons, whatever the operands hold
+		if (first.type != dtype::INT or second.type != dtype::INT) return std::nullopt;
+
+		auto lhs = parse(first);
+		auto rhs = parse(second);
+		if (not lhs or not rhs) return std::nullopt;
+
+		bool holds = false;
+		switch (op)
+		{
+			case opcode::EQ: holds = lhs->integer == rhs->integer; break;
+			case opcode::NE: holds = lhs->integer != rhs->integer; break;
+			case opcode::LT: holds = lhs->integer < rhs->integer; break;
+			case opcode::LE: holds = lhs->integer <= rhs->integer; break;
+			case opcode::GT: holds = lhs->integer > rhs->integer; break;
+			case opcode::GE: holds = lhs->integer >= rhs->integer; break;
+			default: return std::nullopt;
+		}
+		return std::string(holds ? "1" : "0");
+	}
+
+	std::optional<std::string> cast(const Constant& constant, dtype to)
+	{
+		auto value = parse(constant);
+		if (not value) return std::nullopt;
+
+		if (value->type == dtype::INT and to == dtype::REAL)
+		{
+			return spell(static_cast<double>(value->integer));
+		}
+
+		//realtoint rounds the machine's way, only whole numbers are certain
+		if (value->type == dtype::REAL and to == dtype::INT and std::trunc(value->real) == value->real and std::abs(value->real) < 0x1p31)
+		{
+			return spell(static_cast<std::int64_t>(value->real));
+		}
+
+		return std::nullopt;
+	}
+
+	std::optional<std::string> negation(const Constant& constant)
+	{
+		auto value = parse(constant);
+		if (not value) return std::nullopt;
+
+		switch (value->type)
+		{
+			case dtype::INT: return spell(-value->integer);
+			case dtype::REAL: return spell(-value->real);
+			default: return std::nullopt;
+		}
+	}
+}
@@ -0,0 +1,25 @@
+#pragma once
+#include "enums.hpp"
+#include <optional>
+#include <string>
+#include <string_view>
+
+//Compile-time evaluation of instructions whose operands are all constants.
+//Values are read from the spelling of constants and results are spelled back,
+//so the Emitter interns them like literals of the source. Every function
+//computes what the instruction would compute at run time and returns nothing
+//when it cannot tell exactly: overflow, division by zero, or a conversion
+//whose rounding is up to the machine.
+namespace folding
+{
+	struct Constant
+	{
+		dtype type;
+		std::string_view literal;
+	};
+
+	std::optional<std::string> binary(opcode, dtype, const Constant&, const Constant&); //operands promoted to the given type first
+	std::optional<std::string> relation(opcode, const Constant&, const Constant&); //"1" or "0"
+	std::optional<std::string> cast(const Constant&, dtype);
+	std::optional<std::string> negation(const Constant&);
+}
@@ -0,0 +1,154 @@
+#pragma once
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+//"{N}" formatting with the pattern taken apart at compile time. A pattern is a
+//constexpr char array passed as a template argument; a malformed placeholder or
+//an argument count that does not match fails the build instead of printing a
+//wrong line, and formatting is a series of appends without any searching.
+//
+//	constexpr char PAIR[] = "{0}, {1}";
+//	format_to<PAIR>(out, name, 42);
+namespace format
+{
+	struct Piece
+	{
+		std::size_t begin;
+		std::size_t length;
+		int argument; //-1 for literal text
+	};
+
+	//Throwing makes the calling constant expression ill-formed, i.e. a compile error.
+	constexpr std::size_t count_pieces(std::string_view pattern)
+	{
+		std::size_t pieces = 0;
+		bool literal = false;
+
+		for (std::size_t i = 0; i < pattern.size(); ++i)
+		{
+			if (pattern[i] != '{')
+			{
+				pieces += literal ? 0 : 1;
+				literal = true;
+				continue;
+			}
+
+			auto close = pattern.find('}', i);
+			if (close == std::string_view::npos or close == i + 1)
+			{
+				throw "format: unterminated or empty placeholder";
+			}
+			for (auto j = i + 1; j < close; ++j)
+			{
+				if (pattern[j] < '0' or pattern[j] > '9')
+				{
+					throw "format: placeholder is not an argument index";
+				}
+			}
+
+			++pieces;
+			literal = false;
+			i = close;
+		}
+
+		return pieces;
+	}
+
+	template<std::size_t N>
+	constexpr std::array<Piece, N> split(std::string_view pattern)
+	{
+		std::array<Piece, N> pieces{};
+		std::size_t count = 0;
+
+		for (std::size_t i = 0; i < pattern.size();)
+		{
+			if (pattern[i] == '{')
+			{
+				int argument = 0;
+				auto close = pattern.find('}', i);
+				for (auto j = i + 1; j < close; ++j)
+				{
+					argument = argument * 10 + (pattern[j] - '0');
+				}
+				pieces[count++] = Piece{i, 0, argument};
+				i = close + 1;
+				continue;
+			}
+
+			auto next = pattern.find('{', i);
+			auto end = next == std::string_view::npos ? pattern.size() : next;
+			pieces[count++] = Piece{i, end - i, -1};
+			i = end;
+		}
+
+		return pieces;
+	}
+
+	template<std::size_t N>
+	constexpr int arity(const std::array<Piece, N>& pieces)
+	{
+		int arity = 0;
+		for (const auto& piece : pieces)
+		{
+			arity = piece.argument >= arity ? piece.argument + 1 : arity;
+		}
+		return arity;
+	}
+
+	template<const char* Pattern>
+	struct Parsed
+	{
+		constexpr static std::string_view text = Pattern;
+		constexpr static auto pieces = split<count_pieces(text)>(text);
+		constexpr static int arity = format::arity(pieces);
+	};
+
+	inline void append(std::string& out, std::string_view text)
+	{
+		out.append(text);
+	}
+
+	template<typename N, typename = std::enable_if_t<std::is_integral_v<N>>>
+	void append(std::string& out, N number)
+	{
+		char digits[24];
+		auto result = std::to_chars(digits, digits + sizeof(digits), number);
+		out.append(digits, result.ptr);
+	}
+
+	template<typename... Args>
+	void append_argument(std::string& out, int index, const Args&... args)
+	{
+		int position = 0;
+		((position++ == index ? append(out, args) : void()), ...);
+	}
+}
+
+template<const char* Pattern, typename... Args>
+void format_to(std::string& out, const Args&... args)
+{
+	using parsed = format::Parsed<Pattern>;
+	static_assert(parsed::arity == sizeof...(Args), "format: pattern expects a different number of arguments");
+
+	if constexpr (sizeof...(Args) == 0)
+	{
+		out.append(parsed::text);
+		return;
+	}
+
+	for (const auto& piece : parsed::pieces)
+	{
+		if (piece.argument < 0)
+		{
+			out.append(parsed::text.substr(piece.begin, piece.length));
+		}
+		else
+		{
+			format::append_argument(out, piece.argument, args...);
+		}
+	}
+}
@@ -0,0 +1,169 @@
+#include "formatter.hpp"
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+//Instruction formatting throughput: the former iostream layout (setw per field,
+//a map lookup per mnemonic, std::endl per line) against Formatter writing into
+//a reused buffer. Both must produce the same bytes.
+
+namespace
+{
+	struct Instruction
+	{
+		opcode op;
+		std::string suffix;
+		std::vector<std::string> operands;
+		std::string comment;
+	};
+
+	const std::map<opcode, std::string> legacy_mnemonics = {
+		{opcode::ADD, "add"}, {opcode::MUL, "mul"}, {opcode::MOV, "mov"}, {opcode::JMP, "jump"},
+		{opcode::LT, "jl"}, {opcode::WRT, "write"}, {opcode::PSH, "push"}, {opcode::CALL, "call"}
+	};
+
+	constexpr int instructions_per_round = 1 << 16;
+	constexpr int rounds = 32;
+
+	volatile std::size_t sink = 0;
+
+	template<typename Callable>
+	double measure(Callable callable)
+	{
+		auto begin = std::chrono::steady_clock::now();
+		for (int round = 0; round < rounds; ++round)
+		{
+			callable();
+		}
+		std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+		return elapsed.count();
+	}
+
+	std::vector<Instruction> make_program()
+	{
+		const std::vector<Instruction> mix = {
+			{opcode::MOV, ".i", {"#1", "BP-4"}, ";\tmov\t1, i"},
+			{opcode::ADD, ".i", {"BP-4", "#1", "BP-32"}, ";\tadd\ti, 1, $t6"},
+			{opcode::LT, ".i", {"BP-4", "#11", "#jltrue0"}, ";\tjl\ti, 11, jltrue0"},
+			{opcode::MUL, ".r", {"BP+8", "BP-16", "BP-16"}, ";\tmul\tx, $t2, $t2"},
+			{opcode::JMP, ".i", {"#while0"}, ";\tjump\twhile0"},
+			{opcode::WRT, ".i", {"24"}, ";\twrite\tn"},
+			{opcode::PSH, ".i", {"#24"}, ";\tpush\t&n"},
+			{opcode::CALL, ".i", {"#sort"}, ";\tcall\tsort"}
+		};
+
+		std::vector<Instruction> program;
+		for (int i = 0; i < instructions_per_round; ++i)
+		{
+			program.push_back(mix[i % mix.size()]);
+		}
+		return program;
+	}
+
+	//emit_to_stream as it was before Formatter
+	void legacy_emit(std::ostream& stream, const Instruction& instruction)
+	{
+		auto op = legacy_mnemonics.at(instruction.op) + instruction.suffix;
+
+		stream << std::endl << std::setw(8) << std::left;
+		int max_mnemonics = 3;
+		stream << "\t\t" << std::setw(16);
+		stream << op << std::setw(0) << std::right;
+
+		for (const auto& item : instruction.operands)
+		{
+			if (max_mnemonics-- < 3)
+				stream << ",";
+			stream << std::setw(12) << item;
+		}
+
+		for (auto i = 0; i < max_mnemonics; ++i)
+		{
+			stream << std::setw(not i ? 12 : 13) << "";
+		}
+
+		stream << std::setw(16) << "\t" << std::left;
+		stream << instruction.comment << std::setw(0);
+	}
+
+	void emit(Formatter& formatter, std::string& out, const Instruction& instruction)
+	{
+		auto op = std::string(MNEMONICS[static_cast<std::size_t>(instruction.op)]).append(instruction.suffix);
+
+		formatter.begin("", op);
+		for (const auto& item : instruction.operands)
+		{
+			formatter.operand(item);
+		}
+		out.append(formatter.end(instruction.comment));
+	}
+}
+
+int main()
+{
+	const auto program = make_program();
+
+	std::ostringstream legacy_out;
+	for (const auto& instruction : program)
+	{
+		legacy_emit(legacy_out, instruction);
+	}
+
+	Formatter formatter;
+	std::string formatted;
+	for (const auto& instruction : program)
+	{
+		emit(formatter, formatted, instruction);
+	}
+
+	if (legacy_out.str() != formatted)
+	{
+		std::printf("output differs from the iostream layout\n");
+		return 1;
+	}
+
+	auto legacy = measure([&program]()
+	{
+		std::ostringstream out;
+		for (const auto& instruction : program)
+		{
+			legacy_emit(out, instruction);
+		}
+		sink += out.tellp();
+	});
+
+	std::string aligned_out;
+	auto aligned = measure([&program, &formatter, &aligned_out]()
+	{
+		aligned_out.clear();
+		for (const auto& instruction : program)
+		{
+			emit(formatter, aligned_out, instruction);
+		}
+		sink += aligned_out.size();
+	});
+
+	Formatter compact_formatter;
+	compact_formatter.set_compact(true);
+	std::string compact_out;
+	auto compact = measure([&program, &compact_formatter, &compact_out]()
+	{
+		compact_out.clear();
+		for (const auto& instruction : program)
+		{
+			emit(compact_formatter, compact_out, instruction);
+		}
+		sink += compact_out.size();
+	});
+
+	const double instructions = static_cast<double>(instructions_per_round) * rounds;
+	std::printf("iostream: %8.2f Minstr/s\n", instructions / legacy / 1e6);
+	std::printf("aligned:  %8.2f Minstr/s\tspeedup: %.2fx\n", instructions / aligned / 1e6, legacy / aligned);
+	std::printf("compact:  %8.2f Minstr/s\tspeedup: %.2fx\toutput: %zu of %zu bytes\n",
+				instructions / compact / 1e6, legacy / compact, compact_out.size(), formatted.size());
+	return 0;
+}
@@ -0,0 +1,99 @@
+#include "formatter.hpp"
+
+namespace
+{
+	//pads the field that starts at from with spaces up to width
+	void pad(std::string& line, std::size_t from, std::size_t width)
+	{
+		auto used = line.size() - from;
+		if (used < width)
+		{
+			line.append(width - used, ' ');
+		}
+	}
+}
+
+void Formatter::set_compact(bool compact)
+{
+	this->compact = compact;
+}
+
+bool Formatter::is_compact() const
+{
+	return this->compact;
+}
+
+void Formatter::begin(std::string_view label, std::string_view op)
+{
+	this->line.clear();
+	this->operands = 0;
+	this->line += '\n';
+
+	auto start = this->line.size();
+	if (label.empty())
+	{
+		this->line += this->compact ? "\t" : "\t\t";
+	}
+	else
+	{
+		this->line.append(label).append(1, ':');
+	}
+
+	if (this->compact)
+	{
+		if (not op.empty() and not label.empty())
+		{
+			this->line += '\t';
+		}
+		this->line += op;
+		return;
+	}
+
+	pad(this->line, start, Formatter::LABEL_WIDTH);
+	start = this->line.size();
+	this->line += op;
+	pad(this->line, start, Formatter::OP_WIDTH);
+}
+
+void Formatter::operand(std::string_view text)
+{
+	if (this->compact)
+	{
+		this->line += this->operands++ == 0 ? ' ' : ',';
+		this->line += text;
+		return;
+	}
+
+	if (this->operands++ > 0)
+	{
+		this->line += ',';
+	}
+	if (text.size() < Formatter::OPERAND_WIDTH)
+	{
+		this->line.append(Formatter::OPERAND_WIDTH - text.size(), ' ');
+	}
+	this->line += text;
+}
+
+std::string_view Formatter::end(std::string_view comment)
+{
+	if (not this->compact)
+	{
+		//missing operands keep the comment column; only the first gap lacks a comma's width
+		for (int i = 0; i < Formatter::MAX_OPERANDS - this->operands; ++i)
+		{
+			this->line.append(i == 0 ? Formatter::OPERAND_WIDTH : Formatter::OPERAND_WIDTH + 1, ' ');
+		}
+	}
+
+	if (not comment.empty())
+	{
+		if (not this->compact)
+		{
+			this->line.append(Formatter::COMMENT_WIDTH - 1, ' ');
+		}
+		this->line.append(1, '\t').append(comment);
+	}
+
+	return this->line;
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include "enums.hpp"
+#include <array>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+//opcode -> mnemonic, indexed by the enumerator; NOP has no mnemonic
+constexpr std::array<std::string_view, static_cast<std::size_t>(opcode::EXIT) + 1> MNEMONICS = {
+	"", "not", "add", "sub", "mul", "div", "mod", "and", "or",
+	"jne", "jle", "jl", "jge", "jg", "je",
+	"inttoreal", "realtoint", "mov", "jump", "write", "read", "push", "call",
+	"enter", "incsp", "return", "leave", "exit"
+};
+
+static_assert(MNEMONICS[static_cast<std::size_t>(opcode::EQ)] == "je" and MNEMONICS[static_cast<std::size_t>(opcode::EXIT)] == "exit",
+			  "MNEMONICS must follow the order of opcode");
+
+//Lays out one instruction per line in a reused buffer, without stream state.
+//The aligned layout reproduces the listing columns byte for byte: label in 8,
+//opcode in 16, up to three operands right-aligned in 12 and the comment after
+//a tab stop. The compact layout drops the padding for smaller output files.
+class Formatter
+{
+	private:
+		std::string line; //keeps its capacity, so formatting stops allocating after the first lines
+		int operands = 0;
+		bool compact = false;
+
+	public:
+		void set_compact(bool);
+		bool is_compact() const;
+
+		void begin(std::string_view label, std::string_view op); //an empty label indents the instruction
+		void operand(std::string_view);
+		std::string_view end(std::string_view comment); //the finished line, valid until the next begin
+
+		constexpr static std::size_t LABEL_WIDTH = 8;
+		constexpr static std::size_t OP_WIDTH = 16;
+		constexpr static std::size_t OPERAND_WIDTH = 12;
+		constexpr static std::size_t COMMENT_WIDTH = 16; //the tab opening a comment sits at its right edge
+		constexpr static int MAX_OPERANDS = 3;
+};
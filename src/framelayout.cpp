@@ -0,0 +1,36 @@
+#include "framelayout.hpp"
+#include <cstdlib>
+
+int FrameLayout::allocate(const scope& scope, int size)
+{
+	if (scope == scope::LOCAL)
+	{
+		this->local_top -= size;
+		return this->local_top;
+	}
+
+	auto address = this->global_top;
+	this->global_top += size;
+	return address;
+}
+
+int FrameLayout::top(const scope& scope) const
+{
+	return scope == scope::LOCAL ? this->local_top : this->global_top;
+}
+
+int FrameLayout::frame_size() const
+{
+	return std::abs(this->local_top);
+}
+
+void FrameLayout::reset_local()
+{
+	this->local_top = 0;
+}
+
+void FrameLayout::clear()
+{
+	this->global_top = 0;
+	this->local_top = 0;
+}
@@ -0,0 +1,17 @@
+#pragma once
+#include "enums.hpp"
+
+class FrameLayout
+{
+	private:
+		int global_top = 0; //first free byte of global data area
+		int local_top = 0; //lowest BP-relative offset in use by current subprogram
+
+	public:
+		int allocate(const scope&, int);
+		int top(const scope&) const;
+		int frame_size() const;
+
+		void reset_local();
+		void clear();
+};
@@ -0,0 +1,93 @@
+#include "ir.hpp"
+
+namespace ir
+{
+	int Function::link(Instruction instruction, int prev, int next)
+	{
+		int index = static_cast<int>(this->instructions.size());
+		instruction.prev = prev;
+		instruction.next = next;
+		this->instructions.push_back(instruction);
+
+		if (prev == Function::END)
+		{
+			this->head = index;
+		}
+		else
+		{
+			this->instructions[prev].next = index;
+		}
+
+		if (next == Function::END)
+		{
+			this->tail = index;
+		}
+		else
+		{
+			this->instructions[next].prev = index;
+		}
+
+		return index;
+	}
+
+	int Function::append(const Instruction& instruction)
+	{
+		return this->link(instruction, this->tail, Function::END);
+	}
+
+	int Function::prepend(const Instruction& instruction)
+	{
+		return this->link(instruction, Function::END, this->head);
+	}
+
+	int Function::insert_after(int index, const Instruction& instruction)
+	{
+		return this->link(instruction, index, this->instructions[index].next);
+	}
+
+	void Function::erase(int index)
+	{
+		const auto& instruction = this->instructions[index];
+
+		if (instruction.prev == Function::END)
+		{
+			this->head = instruction.next;
+		}
+		else
+		{
+			this->instructions[instruction.prev].next = instruction.next;
+		}
+
+		if (instruction.next == Function::END)
+		{
+			this->tail = instruction.prev;
+		}
+		else
+		{
+			this->instructions[instruction.next].prev = instruction.prev;
+		}
+	}
+
+	void Function::move_to_front(int index)
+	{
+		auto prev = this->instructions[index].prev;
+		if (prev == Function::END)
+		{
+			return;
+		}
+
+		this->instructions[this->tail].next = this->head;
+		this->instructions[this->head].prev = this->tail;
+		this->instructions[prev].next = Function::END;
+		this->instructions[index].prev = Function::END;
+		this->head = index;
+		this->tail = prev;
+	}
+
+	void Function::clear()
+	{
+		this->instructions.clear();
+		this->head = Function::END;
+		this->tail = Function::END;
+	}
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include "enums.hpp"
+#include <cstdint>
+#include <vector>
+
+//Three-address code between the Emitter and the text. Operands name symbols
+//by id, so an instruction is a few words and the spelling of addresses and
+//labels is left to the Printer. Instructions of a function sit in one vector
+//and are chained by index: passes can unlink or insert in constant time and
+//walk them without chasing pointers.
+namespace ir
+{
+	struct Operand
+	{
+		int id; //symbol id, or the value of an immediate
+		bool dereference = false; //see SymTable::append_address
+		bool callable = false;
+		bool immediate = false; //"#id" without a symbol behind it
+
+		static Operand value(int id) { return Operand{id, false, false, true}; }
+	};
+
+	//A label is a NOP whose only operand is the label, procedure or function symbol.
+	struct Instruction
+	{
+		opcode op;
+		dtype type; //operand type, the suffix of the mnemonic; NONE for none
+		std::uint8_t count; //operands in use
+		int prev;
+		int next;
+		Operand operands[3];
+
+		bool is_label() const { return this->op == opcode::NOP; }
+	};
+
+	class Function
+	{
+		private:
+			std::vector<Instruction> instructions;
+			int head = Function::END;
+			int tail = Function::END;
+
+			int link(Instruction, int prev, int next);
+
+		public:
+			const Instruction& operator[](int index) const { return this->instructions[index]; }
+			Instruction& operator[](int index) { return this->instructions[index]; }
+
+			int first() const { return this->head; }
+			int last() const { return this->tail; }
+			bool empty() const { return this->head == Function::END; }
+
+			int append(const Instruction&);
+			int prepend(const Instruction&);
+			int insert_after(int, const Instruction&);
+			void erase(int); //unlinks the instruction; its slot stays until clear()
+			void move_to_front(int); //moves the instructions from the given one to the end in front of the rest
+			void clear(); //keeps the capacity for the next function
+
+			constexpr static int END = -1;
+	};
+}
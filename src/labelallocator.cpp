@@ -0,0 +1,79 @@
+#include "labelallocator.hpp"
+#include <map>
+#include <sstream>
+
+int LabelAllocator::allocate(const scope& scope, const std::string& prefix)
+{
+	auto& counter = this->counters[prefix];
+	int id = LabelAllocator::BASE + this->labels.size();
+
+	this->labels.push_back(Symbol{
+									.m_scope = scope,
+									.m_entry = entry::LABEL,
+									.m_dtype = dtype::NONE,
+									.is_reference = false,
+									.name_id = this->names.intern(prefix + std::to_string(counter++)),
+									.symtab_id = id,
+									.address = -1,
+									.start_ind = 0,
+									.stop_ind = 0
+								 });
+	return id;
+}
+
+Symbol& LabelAllocator::get(int id)
+{
+	return this->labels[id - LabelAllocator::BASE];
+}
+
+std::string_view LabelAllocator::name(const Symbol& label) const
+{
+	return this->names.str(label.name_id);
+}
+
+int LabelAllocator::size() const
+{
+	return this->labels.size();
+}
+
+LabelAllocator::Mark LabelAllocator::mark() const
+{
+	return Mark{this->labels.size(), this->names.mark()};
+}
+
+void LabelAllocator::release(const Mark& mark)
+{
+	this->labels.truncate(mark.size);
+	this->names.release(mark.names);
+}
+
+void LabelAllocator::clear()
+{
+	this->labels.clear();
+	this->names.clear();
+	this->counters.clear();
+}
+
+std::string LabelAllocator::counters_state() const
+{
+	std::map<std::string, int> ordered(this->counters.cbegin(), this->counters.cend());
+	std::string state;
+
+	for (const auto& [prefix, next] : ordered)
+	{
+		state.append(prefix).append("=").append(std::to_string(next)).append("\n");
+	}
+	return state;
+}
+
+void LabelAllocator::restore_counters(const std::string& state)
+{
+	std::istringstream lines(state);
+	this->counters.clear();
+
+	for (std::string line; std::getline(lines, line);)
+	{
+		auto separator = line.find('=');
+		this->counters[line.substr(0, separator)] = std::stoi(line.substr(separator + 1));
+	}
+}
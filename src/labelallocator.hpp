@@ -0,0 +1,37 @@
+#pragma once
+#include "enums.hpp"
+#include "stringpool.hpp"
+#include "symbolstore.hpp"
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+//Jump targets generated by the emitter. They never take part in lookup, so they
+//are kept apart from declared symbols; ids start at BASE to tell them apart.
+class LabelAllocator
+{
+	private:
+		SymbolStore labels;
+		StringPool names;
+		std::unordered_map<std::string, int> counters; //prefix -> next number, never reset so labels stay unique program-wide
+
+	public:
+		struct Mark
+		{
+			int size;
+			StringPool::Mark names;
+		};
+
+		int allocate(const scope&, const std::string&);
+		Symbol& get(int);
+		std::string_view name(const Symbol&) const;
+		int size() const;
+		Mark mark() const;
+		void release(const Mark&);
+		void clear();
+
+		std::string counters_state() const; //"prefix=next" lines in prefix order
+		void restore_counters(const std::string&);
+
+		constexpr static int BASE = 1 << 30;
+};
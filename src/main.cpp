@@ -1,13 +1,15 @@
 #include "global.hpp"
+#include "batch.hpp"
+#include "server.hpp"
+#include "threadpool.hpp"
+#include "subprogramcache.hpp"
+#include <charconv>
 #include <memory>
+#include <optional>
 #include <utility>
 #include <cstdlib>
 #include <iostream>
-
-int lineno = 1;
-std::shared_ptr<Emitter> emitter_ptr;
-std::shared_ptr<SymTable> symtab_ptr;
-std::string backup;
+#include <vector>
 
 std::tuple<std::string, std::string> parse_args(int argc, char* argv[])
 {
@@ -31,8 +33,147 @@ std::tuple<std::string, std::string> parse_args(int argc, char* argv[])
 	return std::make_tuple(first, second);
 }
 
+//splits "-j N"/"-jN" off the arguments following the mode flag
+std::tuple<std::vector<std::string>, unsigned> parse_mode_args(int argc, char* argv[])
+{
+	std::vector<std::string> args;
+	unsigned jobs = ThreadPool::default_size();
+
+	for (int i = 2; i < argc; ++i)
+	{
+		std::string arg = argv[i];
+
+		if (arg.rfind("-j", 0) == 0)
+		{
+			auto value = arg.size() > 2 ? arg.substr(2) : (i + 1 < argc ? std::string(argv[++i]) : std::string());
+			int count = 0;
+			auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), count);
+
+			if (error != std::errc() or end != value.data() + value.size() or count <= 0)
+			{
+				throw CompilerException(interpolate("Invalid number of jobs: \"{0}\"", value), -1);
+			}
+
+			jobs = count;
+			continue;
+		}
+
+		args.push_back(arg);
+	}
+
+	return std::make_tuple(args, jobs);
+}
+
+std::tuple<std::vector<std::string>, unsigned> parse_batch_args(int argc, char* argv[])
+{
+	auto [args, jobs] = parse_mode_args(argc, argv);
+	auto inputs = Batch::expand(args);
+
+	if (inputs.empty())
+	{
+		throw CompilerException("No input files provided to batch compilation", -1);
+	}
+
+	return std::make_tuple(inputs, jobs);
+}
+
+//compiled subprograms are kept across runs when PCA_CACHE_DIR names a directory
+std::unique_ptr<SubprogramCache> open_cache()
+{
+	auto directory = std::getenv("PCA_CACHE_DIR");
+
+	if (directory == nullptr or *directory == '\0')
+	{
+		return nullptr;
+	}
+
+	return std::make_unique<SubprogramCache>(directory);
+}
+
+int compile_batch(int argc, char* argv[])
+{
+	std::vector<std::string> inputs;
+	unsigned jobs;
+	std::unique_ptr<SubprogramCache> cache;
+	try
+	{
+		std::tie(inputs, jobs) = parse_batch_args(argc, argv);
+		cache = open_cache();
+	}
+	catch (CompilerException& ce)
+	{
+		std::cerr << ce.what() << std::endl;
+		return -1;
+	}
+
+	return Batch(inputs, jobs, cache.get()).compile(std::cout) == 0 ? 0 : -2;
+}
+
+int serve(int argc, char* argv[])
+{
+	try
+	{
+		auto [args, jobs] = parse_mode_args(argc, argv);
+
+		if (args.size() != 1)
+		{
+			throw CompilerException(interpolate("Server expects exactly one socket path, got {0}", args.size()), -1);
+		}
+
+		auto cache = open_cache();
+		Server(args.front(), jobs, cache.get()).run();
+	}
+	catch (CompilerException& ce)
+	{
+		std::cerr << ce.what() << std::endl;
+		return -1;
+	}
+
+	return 0;
+}
+
 int main(int argc, char* argv[])
 {
+	if(argc >= 2 and std::string(argv[1]) == "--batch")
+	{
+		return compile_batch(argc, argv);
+	}
+
+	if(argc >= 2 and std::string(argv[1]) == "--serve")
+	{
+		return serve(argc, argv);
+	}
+
+	//flags in front of the file names: "--compact" drops the column alignment,
+	//"--no-comments" the trailing comments, "--symtab[=json]" prints the symbol
+	//tables to stdout as tables or as JSON lines
+	bool compact = false, comments = true;
+	std::optional<dump_format> symtab;
+	for(; argc >= 2; --argc, ++argv)
+	{
+		std::string flag = argv[1];
+		if(flag == "--compact")
+		{
+			compact = true;
+		}
+		else if(flag == "--no-comments")
+		{
+			comments = false;
+		}
+		else if(flag == "--symtab")
+		{
+			symtab = dump_format::TABLE;
+		}
+		else if(flag == "--symtab=json")
+		{
+			symtab = dump_format::JSON;
+		}
+		else
+		{
+			break;
+		}
+	}
+
 	std::string in, out;
 	try 
 	{
@@ -46,13 +187,18 @@ int main(int argc, char* argv[])
 
 	try
 	{
+		auto cache = open_cache();
 		auto compiler = out.empty() ? Compiler(in) : Compiler(in, out);
-
-		emitter_ptr = compiler.share_emitter();
-		symtab_ptr = compiler.share_table();
-		yyin = compiler.get_istream();
-
+		compiler.set_cache(cache.get());
+		compiler.set_compact(compact);
+		compiler.set_annotate(comments);
+		compiler.set_listing(symtab ? &std::cout : nullptr, symtab.value_or(dump_format::TABLE));
 		compiler.compile();
+
+		if (cache != nullptr)
+		{
+			std::cerr << "subprogram cache: " << cache->hit_count() << " hits, " << cache->miss_count() << " misses" << std::endl;
+		}
 	}
 	catch (CompilerException& ce) 
 	{
@@ -0,0 +1,183 @@
+#include "outputfile.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+OutputFile::~OutputFile()
+{
+	this->close();
+}
+
+bool OutputFile::open(const std::string& file_name)
+{
+	this->close();
+
+	this->fd = ::open(file_name.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+	if (this->fd < 0)
+	{
+		return false;
+	}
+
+	struct stat info;
+	this->regular = ::fstat(this->fd, &info) == 0 and S_ISREG(info.st_mode);
+
+	if (this->block == nullptr)
+	{
+		this->block = std::make_unique<char[]>(OutputFile::BLOCK_SIZE);
+	}
+	this->setp(this->block.get(), this->block.get() + OutputFile::BLOCK_SIZE);
+	this->failed = false;
+	return true;
+}
+
+bool OutputFile::is_open() const
+{
+	return this->fd >= 0;
+}
+
+bool OutputFile::is_regular() const
+{
+	return this->regular;
+}
+
+bool OutputFile::close()
+{
+	if (this->fd < 0)
+	{
+		return not this->failed;
+	}
+
+	bool written = this->flush_block() and not this->failed;
+	written = ::close(this->fd) == 0 and written;
+	this->fd = -1;
+	this->setp(nullptr, nullptr);
+	return written;
+}
+
+//Writes every piece, resuming after short writes and staying under IOV_MAX.
+//The pieces are advanced in place.
+bool OutputFile::write_all(iovec* pieces, std::size_t count)
+{
+	while (count > 0)
+	{
+		auto written = ::writev(this->fd, pieces, static_cast<int>(std::min<std::size_t>(count, IOV_MAX)));
+		if (written < 0)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+			this->failed = true;
+			return false;
+		}
+
+		std::size_t left = written;
+		while (count > 0 and left >= pieces->iov_len)
+		{
+			left -= pieces->iov_len;
+			++pieces;
+			--count;
+		}
+
+		if (count > 0)
+		{
+			pieces->iov_base = static_cast<char*>(pieces->iov_base) + left;
+			pieces->iov_len -= left;
+		}
+	}
+
+	return true;
+}
+
+bool OutputFile::flush_block()
+{
+	iovec buffered{this->pbase(), static_cast<std::size_t>(this->pptr() - this->pbase())};
+	bool written = this->write_all(&buffered, 1);
+	this->setp(this->block.get(), this->block.get() + OutputFile::BLOCK_SIZE);
+	return written;
+}
+
+OutputFile::int_type OutputFile::overflow(int_type ch)
+{
+	if (this->fd < 0 or not this->flush_block())
+	{
+		return traits_type::eof();
+	}
+
+	if (not traits_type::eq_int_type(ch, traits_type::eof()))
+	{
+		*this->pptr() = traits_type::to_char_type(ch);
+		this->pbump(1);
+	}
+	return traits_type::not_eof(ch);
+}
+
+std::streamsize OutputFile::xsputn(const char* data, std::streamsize size)
+{
+	if (this->fd < 0)
+	{
+		return 0;
+	}
+
+	if (size > this->epptr() - this->pptr())
+	{
+		iovec piece{const_cast<char*>(data), static_cast<std::size_t>(size)};
+
+		if (static_cast<std::size_t>(size) >= OutputFile::BLOCK_SIZE)
+		{
+			this->splice(&piece, 1);
+			return this->failed ? 0 : size;
+		}
+
+		if (not this->flush_block())
+		{
+			return 0;
+		}
+	}
+
+	std::memcpy(this->pptr(), data, size);
+	this->pbump(static_cast<int>(size));
+	return size;
+}
+
+int OutputFile::sync()
+{
+	return this->fd >= 0 and this->flush_block() ? 0 : -1;
+}
+
+//Small pieces are copied into the block like any other write; once they would
+//overflow it, the block and the pieces leave in a single gathered write.
+void OutputFile::splice(const iovec* pieces, std::size_t count)
+{
+	if (this->fd < 0)
+	{
+		this->failed = true;
+		return;
+	}
+
+	std::size_t total = 0;
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		total += pieces[i].iov_len;
+	}
+
+	if (total <= static_cast<std::size_t>(this->epptr() - this->pptr()))
+	{
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			std::memcpy(this->pptr(), pieces[i].iov_base, pieces[i].iov_len);
+			this->pbump(static_cast<int>(pieces[i].iov_len));
+		}
+		return;
+	}
+
+	this->gather.clear();
+	this->gather.push_back(iovec{this->pbase(), static_cast<std::size_t>(this->pptr() - this->pbase())});
+	this->gather.insert(this->gather.end(), pieces, pieces + count);
+	this->write_all(this->gather.data(), this->gather.size());
+	this->setp(this->block.get(), this->block.get() + OutputFile::BLOCK_SIZE);
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <streambuf>
+#include <string>
+#include <vector>
+#include <sys/uio.h>
+
+//Stream buffer writing the .asm straight to a file descriptor in large blocks,
+//in place of std::ofstream. Subprogram bodies arrive as ChunkBuffer chunks and
+//are spliced in, like writes too big for the free part of the block: they go to
+//writev together with whatever is already buffered, so they reach the kernel
+//without being copied.
+class OutputFile: public std::streambuf
+{
+	private:
+		int fd = -1;
+		std::unique_ptr<char[]> block;
+		bool failed = false; //a write failed; reported by close()
+		bool regular = false; //the last file opened is a regular file, not a device or pipe
+		std::vector<iovec> gather; //block and spliced pieces of one writev
+
+		bool write_all(iovec*, std::size_t);
+		bool flush_block();
+
+	protected:
+		int_type overflow(int_type) override;
+		std::streamsize xsputn(const char*, std::streamsize) override;
+		int sync() override;
+
+	public:
+		OutputFile() = default;
+		OutputFile(const OutputFile&) = delete;
+		OutputFile& operator=(const OutputFile&) = delete;
+		~OutputFile();
+
+		bool open(const std::string&);
+		bool is_open() const;
+		bool is_regular() const;
+		bool close(); //false if anything could not be written
+		void splice(const iovec*, std::size_t); //appends the pieces in order
+
+		constexpr static std::size_t BLOCK_SIZE = 256 * 1024;
+};
@@ -5,27 +5,44 @@
 	#include <algorithm>
 	#include <tuple>
 
-	void yyerror(const std::exception& exc);
-	void yyerror(const char* message);
-
-	int opt_else_helper = 0;
 %}
 
+%code requires {
+	#include "ast.hpp"
+	typedef void* yyscan_t;
+	struct Context;
+}
+
+%code {
+	int yylex(YYSTYPE*, yyscan_t);
+}
+
 %output "parser.cpp"
 %verbose
 %define parse.error verbose
+%define api.pure full
+%lex-param {yyscan_t scanner}
+%parse-param {yyscan_t scanner} {Context& context}
 
 %union	{
 	int int_val;
+	ast::Expression* expression;
+	ast::Statement* statement;
+	ast::ExpressionList expressions;
+	ast::StatementList statements;
 }
 
-%type <int_val> program header program_args variable_decl subprogram_decl block eof identifiers type
-subprogram arguments statements statement_list statement args_decl arg_decl primitives array_decl range 
-dims variables variable expression mulop addop dim_exprs comma_expr optional_else optional_prog_args
-optional_args call inc_or_dec expression_list read write simple_expression term factor num
+%type <int_val> program header program_args variable_decl subprogram_decl eof identifiers type
+subprogram arguments args_decl arg_decl primitives array_decl range dims mulop addop optional_prog_args
+optional_args inc_or_dec
+%type <statement> block statement optional_else call read write
+%type <statements> statements statement_list
+%type <expression> expression simple_expression term factor variable num
+%type <expressions> variables dim_exprs comma_expr expression_list
 
 %token <int_val> PROGRAM BEGIN_TOK END VAR INTEGER REAL ARRAY OF FUN PROC IF THEN ELSE DO WHILE REPEAT
 UNTIL FOR IN TO DOWNTO WRITE READ RANGE RELOP AND_THEN MULOP SIGN ASSIGN AND OR_ELSE OR NOT ID CONST_INT CONST_REAL REAL_FRAG NONE DONE
+%token CACHED
 
 %nonassoc DANGLING
 %nonassoc ELSE
@@ -35,40 +52,51 @@ UNTIL FOR IN TO DOWNTO WRITE READ RANGE RELOP AND_THEN MULOP SIGN ASSIGN AND OR_
 program:
 	PROGRAM ID  optional_prog_args  ';' 
 	{
-		emitter_ptr->begin_parametric_expr();
-		emitter_ptr->begin_parametric_expr();
+		context.emitter.begin_parametric_expr();
+		context.emitter.begin_parametric_expr();
 	} variable_decl
 	{
 		try
 		{
-			emitter_ptr->end_parametric_expr();
-			auto data = emitter_ptr->get_params();
-			symtab_ptr->update_addresses(data);
-			emitter_ptr->end_parametric_expr();
-			emitter_ptr->call_program($2);
-			symtab_ptr->leave_global_scope();
-			symtab_ptr->create_checkpoint();
+			context.emitter.end_parametric_expr();
+			auto data = context.emitter.get_params();
+			context.symtab.update_addresses(data);
+			context.emitter.end_parametric_expr();
+			context.emitter.call_program($2);
+			context.symtab.leave_global_scope();
+			context.symtab.create_checkpoint();
 		}
 		catch(const std::exception& exc)
 		{
-			yyerror(exc);
+			yyerror(context, exc);
 			YYABORT;
 		}
 
 	} subprogram_decl
 	{
-		symtab_ptr->return_to_global_scope();
+		context.symtab.return_to_global_scope();
 		try
 		{
-			emitter_ptr->start_program($2);
+			context.emitter.start_program($2);
 		}
 		catch(const std::exception& exc)
 		{
-			yyerror(exc);
+			yyerror(context, exc);
 			YYABORT;
 		}
 	}
 	block
+	{
+		try
+		{
+			context.generate($10);
+		}
+		catch(const std::exception& exc)
+		{
+			yyerror(context, exc);
+			YYABORT;
+		}
+	}
 	'.'
 	eof
 	;
@@ -81,31 +109,11 @@ optional_prog_args:
 variables:
 	variable
 	{
-		try
-		{
-			auto res = emitter_ptr->variable_or_call($1, true);
-			emitter_ptr->end_parametric_expr();
-			emitter_ptr->store_param(res);
-		}
-		catch(const std::exception& exc)
-		{
-			yyerror(exc);
-			YYABORT;
-		}
+		$$ = ast::Tree::list($1);
 	}
 	| variables ',' variable
 	{
-		try
-		{
-			auto res = emitter_ptr->variable_or_call($3, true);
-			emitter_ptr->end_parametric_expr();
-			emitter_ptr->store_param(res);
-		}
-		catch(const std::exception& exc)
-		{
-			yyerror(exc);
-			YYABORT;
-		}
+		$$ = ast::Tree::append($1, $3);
 	}
 	;
 
@@ -119,18 +127,18 @@ variable_decl:
 	{
 		try
 		{
-			auto data = emitter_ptr->get_params();
+			auto data = context.emitter.get_params();
 			auto computed_type = $5;
-			std::for_each(data.cbegin(), data.cend(), [&computed_type](auto symbol_id)
+			std::for_each(data.cbegin(), data.cend(), [&computed_type, &context](auto symbol_id)
 			{
-				symtab_ptr->update_var(symbol_id, computed_type);
-				emitter_ptr->store_param_on_stack(symbol_id);
+				context.symtab.update_var(symbol_id, computed_type);
+				context.emitter.store_param_on_stack(symbol_id);
 			});
-			emitter_ptr->clear_params();
+			context.emitter.clear_params();
 		}
 		catch(const std::exception& exc)
 		{
-			yyerror(exc);
+			yyerror(context, exc);
 			YYABORT;
 		}
 	}
@@ -140,11 +148,11 @@ variable_decl:
 identifiers:
 	ID
 	{
-		emitter_ptr->store_param($1);
+		context.emitter.store_param($1);
 	}
 	| identifiers ',' ID
 	{
-		emitter_ptr->store_param($3);
+		context.emitter.store_param($3);
 	}
 	;
 
@@ -154,283 +162,169 @@ subprogram_decl:
 	;
 
 subprogram:
-	header 
+	header CACHED
 	{
-		emitter_ptr->begin_parametric_expr();
-		emitter_ptr->begin_parametric_expr();
+		context.splice_subprogram();
+	}
+	| header 
+	{
+		context.emitter.begin_parametric_expr();
+		context.emitter.begin_parametric_expr();
 	} variable_decl
 	{
 		try
 		{
-			emitter_ptr->end_parametric_expr();//stack of variables
-			auto data = emitter_ptr->get_params();
-			symtab_ptr->update_addresses(data);
-			emitter_ptr->end_parametric_expr(); //basic vector
+			context.emitter.end_parametric_expr();//stack of variables
+			auto data = context.emitter.get_params();
+			context.symtab.update_addresses(data);
+			context.emitter.end_parametric_expr(); //basic vector
 		}
 		catch(const std::exception& exc)
 		{
-			yyerror(exc);
+			yyerror(context, exc);
 			YYABORT;
 		}
 	} block
 	{
-		emitter_ptr->end_current_subprogram($1);
+		try
+		{
+			context.generate($5);
+		}
+		catch(const std::exception& exc)
+		{
+			yyerror(context, exc);
+			YYABORT;
+		}
+		context.end_subprogram($1);
 	}
 	;
 
 header:
 	FUN ID
 	{
-		symtab_ptr->leave_global_scope();
-		symtab_ptr->create_checkpoint();
-		symtab_ptr->set_local_scope(local_scope::FUN);
+		context.symtab.leave_global_scope();
+		context.symtab.create_checkpoint();
+		context.symtab.set_local_scope(local_scope::FUN);
 	}
 	arguments
 	':' type
 	{
-		auto data = emitter_ptr->get_params();
+		auto data = context.emitter.get_params();
 		try
 		{
-			symtab_ptr->update_proc_or_fun($2, entry::FUNC, data, $6);
+			context.symtab.update_proc_or_fun($2, entry::FUNC, data, $6);
 		}
 		catch(const std::exception& exc)
 		{
-			yyerror(exc);
+			yyerror(context, exc);
 			YYABORT;
 		}
-		emitter_ptr->end_parametric_expr();
+		context.emitter.end_parametric_expr();
+	}
+	';'
+	{
+		$$ = $2;
+		context.probe_cache();
 	}
-	';' { $$ = $2;}
 	| PROC ID
 	{
-		symtab_ptr->leave_global_scope();
-		symtab_ptr->create_checkpoint();
-		symtab_ptr->set_local_scope(local_scope::PROC);
+		context.symtab.leave_global_scope();
+		context.symtab.create_checkpoint();
+		context.symtab.set_local_scope(local_scope::PROC);
 	}
 	arguments
 	{	
-		auto data = emitter_ptr->get_params();
+		auto data = context.emitter.get_params();
 		try
 		{
-			symtab_ptr->update_proc_or_fun($2, entry::PROC, data);
+			context.symtab.update_proc_or_fun($2, entry::PROC, data);
 		}
 		catch(const std::exception& exc)
 		{
-			yyerror(exc);
+			yyerror(context, exc);
 			YYABORT;
 		}
-		emitter_ptr->end_parametric_expr();
+		context.emitter.end_parametric_expr();
+	}
+	';'
+	{
+		$$ = $2;
+		context.probe_cache();
 	}
-	';' { $$ = $2;}
 	;
 
 block:
 	BEGIN_TOK
 	statements
 	END
+	{
+		$$ = context.tree.statement(ast::statement_kind::COMPOUND, context.lineno);
+		$$->body = $2.first;
+	}
 	;
 
 statements:
 	statement_list
 	| %empty
+	{
+		$$ = ast::StatementList{nullptr, nullptr};
+	}
 	;
 
 statement_list:
 	statement
+	{
+		$$ = ast::Tree::list($1);
+	}
 	| statement_list ';' statement
+	{
+		$$ = ast::Tree::append($1, $3);
+	}
 	;
 
 statement:
-	variable 
-	{
-		try
-		{
-			$1 = emitter_ptr->variable_or_call($1, true);
-			emitter_ptr->end_parametric_expr();
-		}
-		catch(const std::exception& exc)
-		{
-			yyerror(exc);
-			YYABORT;
-		}
-
-	} ASSIGN expression
+	variable ASSIGN expression
 	{	
-		try
-		{
-			emitter_ptr->assign($1, $4);
-		}
-		catch(const std::exception& exc)
-		{
-			yyerror(exc);
-			YYABORT;
-		}
+		$$ = context.tree.statement(ast::statement_kind::ASSIGN, context.lineno);
+		$$->target = $1;
+		$$->value = $3;
 	}
 	| block
 	| write
 	| read
 	| call
-	{
-		try
-		{
-			emitter_ptr->make_call($1, false);
-		}
-		catch(const std::exception& exc)
-		{
-			yyerror(exc);
-			YYABORT;
-		}
-		emitter_ptr->end_parametric_expr();
-	}
-	| 	IF expression
-		{
-			try
-			{
-				$2 = emitter_ptr->if_statement($2);
-			}
-			catch(const std::exception& exc)
-			{
-				yyerror(exc);
-				YYABORT;
-			}
-		} 
-	 	THEN statement
-	  	{
-			try
-			{
-				opt_else_helper = $2;
-				$5 = emitter_ptr->end_if();
-			}
-			catch(const std::exception& exc)
-			{
-				yyerror(exc);
-				YYABORT;
-			}
-		}
-	  	optional_else
+	| 	IF expression THEN statement optional_else
 		{
-
-			if($7 != opt_else_helper)
-			{		
-				try
-				{
-					emitter_ptr->label(opt_else_helper);
-				}
-				catch(const std::exception& exc)
-				{
-					yyerror(exc);
-					YYABORT;
-				}
-			}
-
-			try
-			{
-				emitter_ptr->label($5);
-			}
-			catch(const std::exception& exc)
-			{
-				yyerror(exc);
-				YYABORT;
-			}
+			$$ = context.tree.statement(ast::statement_kind::IF, context.lineno);
+			$$->value = $2;
+			$$->body = $4;
+			$$->alternative = $5;
 		}
-	| 	WHILE 
+	| 	WHILE expression DO statement
 		{
-			$1 = emitter_ptr->begin_while();
-		} expression
-		{
-			try
-			{
-				$3 = emitter_ptr->while_statement($3);
-			}
-			catch(const std::exception& exc)
-			{
-				yyerror(exc);
-				YYABORT;
-			}
+			$$ = context.tree.statement(ast::statement_kind::WHILE, context.lineno);
+			$$->value = $2;
+			$$->body = $4;
 		}
-	  	DO statement
-	  	{
-			try
-			{
-				emitter_ptr->jump($1);
-				emitter_ptr->label($3);
-			}
-			catch(const std::exception& exc)
-			{
-				yyerror(exc);
-				YYABORT;
-			}
-	  	}
-	|	FOR ID
+	|	FOR ID IN ID DO statement
 		{
-			
+			$$ = context.tree.statement(ast::statement_kind::FOR_IN, context.lineno);
+			$$->body = $6;
 		}
-		IN ID
+	|	FOR variable ASSIGN expression inc_or_dec expression DO statement
 		{
-
+			$$ = context.tree.statement(ast::statement_kind::FOR, context.lineno);
+			$$->target = $2;
+			$$->value = $4;
+			$$->op = $5;
+			$$->limit = $6;
+			$$->body = $8;
 		}
-		DO statement
+	|	REPEAT statement UNTIL expression
 		{
-
-		}
-	|	FOR variable 
-		{
-			try
-			{
-				$2 = emitter_ptr->variable_or_call($2, true);
-				emitter_ptr->end_parametric_expr();
-			}
-			catch(const std::exception& exc)
-			{
-				yyerror(exc);
-				YYABORT;
-			}
-		} ASSIGN expression inc_or_dec expression
-		{
-			try
-			{
-				std::tie($1, $4) = emitter_ptr->classic_for_statement($2, $5, $6, $7);
-			}
-			catch(const std::exception& exc)
-			{
-				yyerror(exc);
-				YYABORT;
-			}
-		} DO statement
-		{
-			try
-			{
-				emitter_ptr->classic_end_iteration($2, $6, $1);
-				emitter_ptr->label($4);
-			}
-			catch(const std::exception& exc)
-			{
-				yyerror(exc);
-				YYABORT;
-			}
-		}
-	|	REPEAT 
-		{
-			try
-			{
-				$1 = emitter_ptr->repeat();
-			}
-			catch(const std::exception& exc)
-			{
-				yyerror(exc);
-				YYABORT;
-			}
-		} statement	UNTIL expression
-		{
-			try
-			{
-				emitter_ptr->until($1, $5);
-			}
-			catch(const std::exception& exc)
-			{
-				yyerror(exc);
-				YYABORT;
-			}
+			$$ = context.tree.statement(ast::statement_kind::REPEAT, context.lineno);
+			$$->body = $2;
+			$$->value = $4;
 		}
 	;
 
@@ -446,74 +340,43 @@ inc_or_dec:
 	;
 
 optional_else:
-	ELSE 
+	ELSE statement 
 	{
-		try
-		{
-			emitter_ptr->label(opt_else_helper);
-		}
-		catch(const std::exception& exc)
-		{
-			yyerror(exc);
-			YYABORT;
-		}
-	} statement 
-	{
-		$$ = opt_else_helper;
+		$$ = $2;
 	}
 	| %empty  %prec DANGLING
+	{
+		$$ = nullptr;
+	}
 	;
 
 read:
-	READ '(' 
-	{
-		emitter_ptr->begin_parametric_expr();
-	} variables ')'
+	READ '(' variables ')'
 	{
-		try
-		{
-			emitter_ptr->read();
-		}
-		catch(const std::exception& exc)
-		{
-			yyerror(exc);
-			YYABORT;
-		}
-		emitter_ptr->end_parametric_expr();
+		$$ = context.tree.statement(ast::statement_kind::READ, context.lineno);
+		$$->arguments = $3.first;
 	}
 	;
 
 write:
-	WRITE '(' 
+	WRITE '(' expression_list ')'
 	{
-		emitter_ptr->begin_parametric_expr();
-	} expression_list ')'
-	{
-		try
-		{
-			emitter_ptr->write();
-		}
-		catch(const std::exception& exc)
-		{
-			yyerror(exc);
-			YYABORT;
-		}
-		emitter_ptr->end_parametric_expr();
+		$$ = context.tree.statement(ast::statement_kind::WRITE, context.lineno);
+		$$->arguments = $3.first;
 	}
 	;
 
 call:
 	ID
 	{
-		emitter_ptr->begin_parametric_expr();
-		$$ = $1;
+		$$ = context.tree.statement(ast::statement_kind::CALL, context.lineno);
+		$$->symbol = $1;
 	}
-	| ID '(' 
-	{
-		emitter_ptr->begin_parametric_expr();
-	} expression_list ')'
+	| ID '(' expression_list ')'
 	{
-		$$ = $1;
+		$$ = context.tree.statement(ast::statement_kind::CALL, context.lineno);
+		$$->symbol = $1;
+		$$->arguments = $3.first;
 	}
 	;
 
@@ -524,38 +387,15 @@ expression:
 	}
 	| simple_expression RELOP simple_expression
 	{
-		try
-		{
-			$$ = emitter_ptr->binary_op($2, $1, $3);
-		}
-		catch(const std::exception& exc)
-		{
-			yyerror(exc);
-			YYABORT;
-		}
+		$$ = context.tree.expression(ast::expression_kind::BINARY, context.lineno, SymTable::NONE, $2);
+		$$->left = $1;
+		$$->right = $3;
 	}
-	| simple_expression OR_ELSE
-	{
-		try
-		{
-			$2 = emitter_ptr->begin_or_else($1);
-		}
-		catch(const std::exception& exc)
-		{
-			yyerror(exc);
-			YYABORT;
-		}
-	} simple_expression
+	| simple_expression OR_ELSE simple_expression
 	{
-		try
-		{
-			$$ = emitter_ptr->or_else($2, $4);
-		}
-		catch(const std::exception& exc)
-		{
-			yyerror(exc);
-			YYABORT;
-		}
+		$$ = context.tree.expression(ast::expression_kind::OR_ELSE, context.lineno);
+		$$->left = $1;
+		$$->right = $3;
 	}
 	;
 
@@ -566,27 +406,14 @@ simple_expression:
 	}
 	| SIGN term
 	{
-		try
-		{
-			$$ = emitter_ptr->unary_op($1, $2);
-		}
-		catch(const std::exception& exc)
-		{
-			yyerror(exc);
-			YYABORT;
-		}
+		$$ = context.tree.expression(ast::expression_kind::UNARY, context.lineno, SymTable::NONE, $1);
+		$$->left = $2;
 	}
 	| simple_expression addop term
 	{
-		try
-		{
-			$$ = emitter_ptr->binary_op($2, $1, $3);
-		}
-		catch(const std::exception& exc)
-		{
-			yyerror(exc);
-			YYABORT;
-		}
+		$$ = context.tree.expression(ast::expression_kind::BINARY, context.lineno, SymTable::NONE, $2);
+		$$->left = $1;
+		$$->right = $3;
 	}
 	;
 
@@ -595,73 +422,26 @@ term:
 	{
 		$$ = $1;
 	}
-	| term AND_THEN
+	| term AND_THEN factor
 	{
-		try
-		{
-			$2 = emitter_ptr->begin_and_then($1);
-		}
-		catch(const std::exception& exc)
-		{
-			yyerror(exc);
-			YYABORT;
-		}
-	} factor
-	{
-		try
-		{
-			$$ = emitter_ptr->and_then($2, $4);
-		}
-		catch(const std::exception& exc)
-		{
-			yyerror(exc);
-			YYABORT;
-		}
+		$$ = context.tree.expression(ast::expression_kind::AND_THEN, context.lineno);
+		$$->left = $1;
+		$$->right = $3;
 	}
 	| term mulop factor
 	{	
-		try
-		{
-			$$ = emitter_ptr->binary_op($2, $1, $3);
-		}
-		catch(const std::exception& exc)
-		{
-			yyerror(exc);
-			YYABORT;
-		}	
+		$$ = context.tree.expression(ast::expression_kind::BINARY, context.lineno, SymTable::NONE, $2);
+		$$->left = $1;
+		$$->right = $3;
 	}
 	;
 
 factor:
 	variable 
+	| ID '(' expression_list ')'
 	{
-		try
-		{
-			$$ = emitter_ptr->variable_or_call($1);
-			emitter_ptr->end_parametric_expr();
-		}
-		catch(const std::exception& exc)
-		{
-			yyerror(exc);
-			YYABORT;
-		}
-	}
-	| ID '(' 
-	{
-		emitter_ptr->begin_parametric_expr();	
-	} expression_list ')'
-	{
-		try
-		{
-			auto optional_result = emitter_ptr->make_call($1, true);
-			$$ = optional_result.value_or(SymTable::NONE);
-		}
-		catch(const std::exception& exc)
-		{
-			yyerror(exc);
-			YYABORT;
-		}
-		emitter_ptr->end_parametric_expr();
+		$$ = context.tree.expression(ast::expression_kind::CALL, context.lineno, $1);
+		$$->arguments = $3.first;
 	}
 	| num
 	| '(' expression ')'
@@ -670,78 +450,57 @@ factor:
 	}
 	| NOT factor
 	{
-		try
-		{
-			$$ = emitter_ptr->unary_op($1, $2);
-		}
-		catch(const std::exception& exc)
-		{
-			yyerror(exc);
-			YYABORT;
-		}
+		$$ = context.tree.expression(ast::expression_kind::UNARY, context.lineno, SymTable::NONE, $1);
+		$$->left = $2;
 	}
 	;
 
 expression_list: 
 	comma_expr
 	| %empty
+	{
+		$$ = ast::ExpressionList{nullptr, nullptr};
+	}
 	;
 
 variable:
 	ID
 	{
-		emitter_ptr->begin_parametric_expr();
-
-		try
-		{
-			$$ = symtab_ptr->check_symbol($1, true).symtab_id;
-		}
-		catch(const std::exception& exc)
-		{
-			yyerror(exc);
-			YYABORT;
-		}
+		$$ = context.tree.expression(ast::expression_kind::VARIABLE, context.lineno, $1);
 	}
 	| ID dim_exprs
 	{
-		try
-		{
-			$$ = symtab_ptr->check_symbol($1, true).symtab_id;
-		}
-		catch(const std::exception& exc)
-		{
-			yyerror(exc);
-			YYABORT;
-		}
+		$$ = context.tree.expression(ast::expression_kind::VARIABLE, context.lineno, $1);
+		$$->arguments = $2.first;
 	}
 	;
 
 dim_exprs:
-	'[' 
+	'[' comma_expr ']'
 	{
-		emitter_ptr->begin_parametric_expr();
-	} comma_expr ']'
-	
+		$$ = $2;
+	}
+	;
 
 comma_expr:
 	expression
 	{
-		emitter_ptr->store_param($1);
+		$$ = ast::Tree::list($1);
 	}
 	| comma_expr ',' expression
 	{
-		emitter_ptr->store_param($3);
+		$$ = ast::Tree::append($1, $3);
 	}
 	;
 
 arguments:
 	'(' 
 	{
-		emitter_ptr->begin_parametric_expr();
-		emitter_ptr->begin_parametric_expr();
+		context.emitter.begin_parametric_expr();
+		context.emitter.begin_parametric_expr();
 	} optional_args ')'
 	{
-		emitter_ptr->end_parametric_expr();
+		context.emitter.end_parametric_expr();
 	}
 	| %empty
 	;
@@ -761,17 +520,17 @@ arg_decl:
 	{
 		try
 		{
-			auto data = emitter_ptr->get_params();
+			auto data = context.emitter.get_params();
 			auto computed_type = $4;
-			std::for_each(data.cbegin(), data.cend(), [&computed_type](auto symbol_id){
-				symtab_ptr->update_var(symbol_id, computed_type, true);
-				emitter_ptr->store_param_on_stack(symbol_id);
+			std::for_each(data.cbegin(), data.cend(), [&computed_type, &context](auto symbol_id){
+				context.symtab.update_var(symbol_id, computed_type, true);
+				context.emitter.store_param_on_stack(symbol_id);
 			});
-			emitter_ptr->clear_params();
+			context.emitter.clear_params();
 		}
 		catch(const std::exception& exc)
 		{
-			yyerror(exc);
+			yyerror(context, exc);
 			YYABORT;
 		}
 	}
@@ -779,17 +538,17 @@ arg_decl:
 	{
 		try
 		{
-			auto data = emitter_ptr->get_params();
+			auto data = context.emitter.get_params();
 			auto computed_type = $3;
-			std::for_each(data.cbegin(), data.cend(), [&computed_type](auto symbol_id){
-				symtab_ptr->update_var(symbol_id, computed_type);
-				emitter_ptr->store_param_on_stack(symbol_id);
+			std::for_each(data.cbegin(), data.cend(), [&computed_type, &context](auto symbol_id){
+				context.symtab.update_var(symbol_id, computed_type);
+				context.emitter.store_param_on_stack(symbol_id);
 			});
-			emitter_ptr->clear_params();
+			context.emitter.clear_params();
 		}
 		catch(const std::exception& exc)
 		{
-			yyerror(exc);
+			yyerror(context, exc);
 			YYABORT;
 		}
 	}
@@ -809,11 +568,11 @@ primitives:
 dims:
 	range
 	{
-		emitter_ptr->store_param($1);
+		context.emitter.store_param($1);
 	}
 	| dims ',' range
 	{
-		emitter_ptr->store_param($3);
+		context.emitter.store_param($3);
 	}
 	;
 
@@ -822,11 +581,11 @@ range:
 	{
 		try
 		{
-			$$ = symtab_ptr->insert_range($1, $3);
+			$$ = context.symtab.insert_range($1, $3);
 		}
 		catch(const std::exception& exc)
 		{
-			yyerror(exc);
+			yyerror(context, exc);
 			YYABORT;
 		}
 	}
@@ -835,7 +594,7 @@ range:
 array_decl:
 	'[' 
 	{
-		emitter_ptr->begin_parametric_expr();
+		context.emitter.begin_parametric_expr();
 	} dims ']' 
 	;
 
@@ -845,26 +604,32 @@ type:
 	{
 		try
 		{
-			auto data = emitter_ptr->get_params();
+			auto data = context.emitter.get_params();
 			auto type = dtype($4);
-			$$ = symtab_ptr->insert_array_type(data, type);
+			$$ = context.symtab.insert_array_type(data, type);
 		}
 		catch(const std::exception& exc)
 		{
-			yyerror(exc);
+			yyerror(context, exc);
 			YYABORT;
 		}
 
-		emitter_ptr->end_parametric_expr();
+		context.emitter.end_parametric_expr();
 	}
 	;
 
 num:
 	CONST_INT
+	{
+		$$ = context.tree.expression(ast::expression_kind::VALUE, context.lineno, $1);
+	}
 	| CONST_REAL
+	{
+		$$ = context.tree.expression(ast::expression_kind::VALUE, context.lineno, $1);
+	}
 	| REAL_FRAG CONST_REAL 
 	{
-		$$ = $2;
+		$$ = context.tree.expression(ast::expression_kind::VALUE, context.lineno, $2);
 	}
 	;
 
@@ -881,18 +646,29 @@ mulop:
 eof:
 	DONE
 	{
-		emitter_ptr->end_program();
+		context.emitter.end_program();
 		return 0;
 	}
 	;
 %%
 
-void yyerror(const std::exception& exc)
+void yyerror(Context& context, const std::exception& exc)
 {
-	std::cerr << exc.what() << std::endl;
+	const auto* error = dynamic_cast<const CompilerException*>(&exc);
+	context.errors.push_back(error != nullptr ? Diagnostic{error->lineno, error->reason()} : Diagnostic{context.lineno, exc.what()});
+
+	if(context.diagnostics != nullptr)
+	{
+		*context.diagnostics << exc.what() << std::endl;
+	}
 }
 
-void yyerror(const char* message)
+void yyerror(yyscan_t, Context& context, const char* message)
 {
-	std::cerr << message << ".\tAt line: " << lineno << std::endl;
+	context.errors.push_back(Diagnostic{context.lineno, message});
+
+	if(context.diagnostics != nullptr)
+	{
+		*context.diagnostics << message << ".\tAt line: " << context.lineno << std::endl;
+	}
 }
\ No newline at end of file
@@ -0,0 +1,42 @@
+#include "pca.hpp"
+#include "compiler.hpp"
+#include <sstream>
+
+namespace pca
+{
+	Result compile(std::string_view source, const Options& options)
+	{
+		Result result;
+		std::ostringstream assembly, listing;
+		Compiler compiler(source, assembly);
+
+		compiler.set_diagnostics(nullptr);
+		compiler.set_listing(options.listing ? &listing : nullptr, options.listing_json ? dump_format::JSON : dump_format::TABLE);
+		compiler.set_compact(options.compact);
+		compiler.set_annotate(options.comments);
+
+		try
+		{
+			compiler.compile();
+			result.succeeded = compiler.succeeded();
+		}
+		catch (const CompilerException& exc)
+		{
+			result.diagnostics.push_back(Diagnostic{exc.lineno, exc.reason()});
+		}
+		catch (const std::exception& exc)
+		{
+			result.diagnostics.push_back(Diagnostic{-1, exc.what()});
+		}
+
+		result.diagnostics.insert(result.diagnostics.begin(), compiler.errors().cbegin(), compiler.errors().cend());
+
+		if (result.succeeded)
+		{
+			result.assembly = assembly.str();
+		}
+
+		result.listing = listing.str();
+		return result;
+	}
+}
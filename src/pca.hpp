@@ -0,0 +1,28 @@
+#pragma once
+#include "diagnostic.hpp"
+#include <string>
+#include <string_view>
+#include <vector>
+
+//Entry point of libpca: compiles a program held in memory. Nothing is read from
+//or written to files, stdout or stderr, and concurrent calls are independent.
+namespace pca
+{
+	struct Options
+	{
+		bool listing = false; //collect the symbol table dumps the command line compiler prints with --symtab
+		bool listing_json = false; //the dumps as JSON lines, see SymTable::dump_json
+		bool compact = false; //unaligned instructions, smaller but harder to read
+		bool comments = true; //trailing comments naming the operands
+	};
+
+	struct Result
+	{
+		bool succeeded = false;
+		std::string assembly; //empty unless succeeded
+		std::vector<Diagnostic> diagnostics;
+		std::string listing;
+	};
+
+	Result compile(std::string_view source, const Options& options = Options());
+}
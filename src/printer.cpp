@@ -0,0 +1,184 @@
+#include "printer.hpp"
+#include "symtable.hpp"
+#include "format.hpp"
+#include <charconv>
+
+//trailing comments of instructions, formatted only when the output is annotated
+namespace comment
+{
+	constexpr char NULLARY[] = ";\t{0}";
+	constexpr char UNARY[] = ";\t{0}\t{1}";
+	constexpr char BINARY[] = ";\t{0}\t{1}, {2}";
+	constexpr char TERNARY[] = ";\t{0}\t{1}, {2}, {3}";
+	constexpr char MOVE_POINTER[] = ";\t{0}\t&{1}, &{2}";
+	constexpr char SHIFT_POINTER[] = ";\t{0}\t&{1}, {2}, &{3}";
+	constexpr char EXIT[] = ";\texit.";
+}
+
+void Printer::set_compact(bool compact)
+{
+	this->formatter.set_compact(compact);
+}
+
+bool Printer::is_compact() const
+{
+	return this->formatter.is_compact();
+}
+
+void Printer::set_annotate(bool annotate)
+{
+	this->annotate = annotate;
+}
+
+bool Printer::is_annotated() const
+{
+	return this->annotate;
+}
+
+std::string_view Printer::suffix(dtype type)
+{
+	switch (type)
+	{
+		case dtype::REAL:
+		{
+			return ".r";
+		}
+		case dtype::INT:
+		{
+			return ".i";
+		}
+		default:
+		{
+			return "";
+		}
+	}
+}
+
+void Printer::print(const ir::Function& function, std::ostream& out)
+{
+	for (auto index = function.first(); index != ir::Function::END; index = function[index].next)
+	{
+		this->print(function[index], out);
+	}
+}
+
+void Printer::print(const ir::Instruction& instruction, std::ostream& out)
+{
+	this->comment_text.clear();
+
+	if (instruction.is_label())
+	{
+		this->formatter.begin(this->symtab.name(this->symtab.get(instruction.operands[0].id)), "");
+	}
+	else
+	{
+		this->op_text.assign(MNEMONICS[static_cast<std::size_t>(instruction.op)]).append(Printer::suffix(instruction.type));
+		this->formatter.begin("", this->op_text);
+
+		for (int i = 0; i < instruction.count; ++i)
+		{
+			this->operand(instruction.operands[i]);
+		}
+
+		if (this->annotate)
+		{
+			this->comment(instruction);
+		}
+	}
+
+	auto line = this->formatter.end(this->comment_text);
+	out.write(line.data(), line.size());
+}
+
+void Printer::operand(const ir::Operand& operand)
+{
+	this->operand_text.clear();
+
+	if (operand.immediate)
+	{
+		char digits[16];
+		auto result = std::to_chars(digits, digits + sizeof(digits), operand.id);
+		this->operand_text.append(1, '#').append(digits, result.ptr);
+	}
+	else
+	{
+		this->symtab.append_address(this->operand_text, this->symtab.get(operand.id), operand.dereference, operand.callable);
+	}
+
+	this->formatter.operand(this->operand_text);
+}
+
+std::string_view Printer::name(const ir::Operand& operand, char (&digits)[16])
+{
+	if (operand.immediate)
+	{
+		auto result = std::to_chars(digits, digits + sizeof(digits), operand.id);
+		return std::string_view(digits, result.ptr - digits);
+	}
+
+	return this->symtab.name(this->symtab.get(operand.id));
+}
+
+//Operands are named as in the source. Moves and additions of addresses mark
+//them with '&', and casts spell out the type they convert from.
+void Printer::comment(const ir::Instruction& instruction)
+{
+	auto op = instruction.op;
+	std::string_view mnemonic = op == opcode::I2R or op == opcode::R2I ? std::string_view(this->op_text) : MNEMONICS[static_cast<std::size_t>(op)];
+
+	const auto& operands = instruction.operands;
+	bool pointer = (op == opcode::MOV or op == opcode::ADD) and instruction.count > 0 and not operands[0].dereference and not operands[0].immediate;
+	char digits[3][16];
+
+	switch (instruction.count)
+	{
+		case 0:
+		{
+			if (op == opcode::EXIT)
+			{
+				format_to<comment::EXIT>(this->comment_text);
+			}
+			else
+			{
+				format_to<comment::NULLARY>(this->comment_text, mnemonic);
+			}
+			break;
+		}
+		case 1:
+		{
+			format_to<comment::UNARY>(this->comment_text, mnemonic, this->name(operands[0], digits[0]));
+			break;
+		}
+		case 2:
+		{
+			auto first = this->name(operands[0], digits[0]);
+			auto second = this->name(operands[1], digits[1]);
+
+			if (pointer)
+			{
+				format_to<comment::MOVE_POINTER>(this->comment_text, mnemonic, first, second);
+			}
+			else
+			{
+				format_to<comment::BINARY>(this->comment_text, mnemonic, first, second);
+			}
+			break;
+		}
+		default:
+		{
+			auto first = this->name(operands[0], digits[0]);
+			auto second = this->name(operands[1], digits[1]);
+			auto third = this->name(operands[2], digits[2]);
+
+			if (pointer)
+			{
+				format_to<comment::SHIFT_POINTER>(this->comment_text, mnemonic, first, second, third);
+			}
+			else
+			{
+				format_to<comment::TERNARY>(this->comment_text, mnemonic, first, second, third);
+			}
+			break;
+		}
+	}
+}
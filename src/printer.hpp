@@ -0,0 +1,39 @@
+#pragma once
+#include "ir.hpp"
+#include "formatter.hpp"
+#include <ostream>
+#include <string>
+#include <string_view>
+
+class SymTable;
+
+//Turns three-address code into assembly text, one Formatter line per
+//instruction. Addresses and names are looked up in the SymTable when printing,
+//so a function has to be printed before its symbols are dropped.
+class Printer
+{
+	private:
+		SymTable& symtab;
+		Formatter formatter;
+		std::string op_text; //mnemonic with its type suffix
+		std::string operand_text;
+		std::string comment_text;
+		bool annotate = true; //trailing comments with the source names of the operands
+
+		void operand(const ir::Operand&);
+		void comment(const ir::Instruction&);
+		std::string_view name(const ir::Operand&, char (&digits)[16]);
+
+	public:
+		explicit Printer(SymTable& symtab): symtab(symtab) {};
+
+		void set_compact(bool); //unaligned instructions, see Formatter
+		bool is_compact() const;
+		void set_annotate(bool); //comments are on by default
+		bool is_annotated() const;
+
+		void print(const ir::Instruction&, std::ostream&);
+		void print(const ir::Function&, std::ostream&);
+
+		static std::string_view suffix(dtype);
+};
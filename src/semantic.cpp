@@ -0,0 +1,49 @@
+#include "semantic.hpp"
+#include "symtable.hpp"
+
+void SemanticPass::run(ast::Statement* body)
+{
+	this->statement(body);
+}
+
+void SemanticPass::statement(ast::Statement* node)
+{
+	for (; node != nullptr; node = node->next)
+	{
+		//source order, in which the parser used to report the first error
+		bool body_first = node->kind == ast::statement_kind::REPEAT;
+
+		if (body_first)
+		{
+			this->statement(node->body);
+		}
+
+		for (auto expression : {node->target, node->value, node->limit, node->arguments})
+		{
+			this->expression(expression);
+		}
+
+		if (not body_first)
+		{
+			this->statement(node->body);
+		}
+		this->statement(node->alternative);
+	}
+}
+
+//Walks a chain of expressions: argument lists are linked through next.
+void SemanticPass::expression(ast::Expression* node)
+{
+	for (; node != nullptr; node = node->next)
+	{
+		this->expression(node->left);
+		this->expression(node->arguments);
+		this->expression(node->right);
+
+		if (node->kind == ast::expression_kind::VARIABLE)
+		{
+			this->lineno = node->line;
+			node->symbol = this->symtab.check_symbol(node->symbol, true).symtab_id;
+		}
+	}
+}
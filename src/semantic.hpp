@@ -0,0 +1,21 @@
+#pragma once
+#include "ast.hpp"
+
+class SymTable;
+
+//First pass over a finished body: binds the variables to their symbols, so an
+//undeclared identifier is reported before any code of the body is generated.
+class SemanticPass
+{
+	private:
+		SymTable& symtab;
+		int& lineno; //moved to each node's line, so errors point at the source
+
+		void statement(ast::Statement*);
+		void expression(ast::Expression*);
+
+	public:
+		SemanticPass(SymTable& symtab, int& lineno): symtab(symtab), lineno(lineno) {};
+
+		void run(ast::Statement*);
+};
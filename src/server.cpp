@@ -0,0 +1,277 @@
+#include "server.hpp"
+#include "compiler.hpp"
+#include "threadpool.hpp"
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace
+{
+	class Connection
+	{
+		private:
+			int fd;
+			std::string buffer; //bytes received but not consumed yet
+
+			bool fill()
+			{
+				char chunk[16 * 1024];
+				while (true)
+				{
+					auto received = ::recv(this->fd, chunk, sizeof(chunk), 0);
+					if (received > 0)
+					{
+						this->buffer.append(chunk, received);
+						return true;
+					}
+					if (received < 0 and errno == EINTR)
+					{
+						continue;
+					}
+					return false;
+				}
+			}
+
+		public:
+			explicit Connection(int fd): fd(fd) {};
+
+			bool read_line(std::string& line)
+			{
+				std::size_t end;
+				while ((end = this->buffer.find('\n')) == std::string::npos)
+				{
+					if (this->buffer.size() > 1024 or not this->fill())
+					{
+						return false;
+					}
+				}
+
+				line = this->buffer.substr(0, end);
+				this->buffer.erase(0, end + 1);
+				return true;
+			}
+
+			bool read_exact(std::size_t size, std::string& data)
+			{
+				while (this->buffer.size() < size)
+				{
+					if (not this->fill())
+					{
+						return false;
+					}
+				}
+
+				data = this->buffer.substr(0, size);
+				this->buffer.erase(0, size);
+				return true;
+			}
+
+			bool write(const std::string& data)
+			{
+				std::size_t sent = 0;
+				while (sent < data.size())
+				{
+					auto written = ::send(this->fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+					if (written < 0)
+					{
+						if (errno == EINTR)
+						{
+							continue;
+						}
+						return false;
+					}
+					sent += written;
+				}
+				return true;
+			}
+	};
+
+	bool is_socket(const char* path)
+	{
+		struct stat status;
+		return ::lstat(path, &status) == 0 and S_ISSOCK(status.st_mode);
+	}
+
+	//a socket nobody accepts on any more, left behind by a server that is gone
+	bool is_stale(const sockaddr_un& address)
+	{
+		if (not is_socket(address.sun_path))
+		{
+			return false;
+		}
+
+		int probe = ::socket(AF_UNIX, SOCK_STREAM, 0);
+		if (probe < 0)
+		{
+			return false;
+		}
+
+		auto refused = ::connect(probe, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 and errno == ECONNREFUSED;
+		::close(probe);
+		return refused;
+	}
+}
+
+Server::Server(std::string path, unsigned jobs, SubprogramCache* cache): path(std::move(path)), jobs(jobs), cache(cache)
+{
+	sockaddr_un address{};
+	address.sun_family = AF_UNIX;
+
+	if (this->path.size() >= sizeof(address.sun_path))
+	{
+		throw CompilerException(interpolate("Runtime error. Socket path \"{0}\" is too long.", this->path), -1);
+	}
+	std::strcpy(address.sun_path, this->path.c_str());
+
+	this->listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+	if (this->listener < 0)
+	{
+		throw CompilerException(interpolate("Runtime error. Cannot create socket: {0}", std::strerror(errno)), -1);
+	}
+
+	//a socket file left behind by a previous server would make bind fail; a
+	//live server's socket or any other file is left alone and bind reports it
+	if (is_stale(address))
+	{
+		::unlink(this->path.c_str());
+	}
+
+	if (::bind(this->listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 or ::listen(this->listener, SOMAXCONN) != 0)
+	{
+		auto reason = std::strerror(errno);
+		::close(this->listener);
+		throw CompilerException(interpolate("Runtime error. Cannot listen on \"{0}\": {1}", this->path, reason), -1);
+	}
+}
+
+Server::~Server()
+{
+	if (this->listener >= 0)
+	{
+		::close(this->listener);
+		if (is_socket(this->path.c_str()))
+		{
+			::unlink(this->path.c_str());
+		}
+	}
+}
+
+void Server::run()
+{
+	ThreadPool pool(this->jobs);
+
+	while (true)
+	{
+		int client = ::accept(this->listener, nullptr, nullptr);
+		if (client < 0)
+		{
+			if (errno == EINTR or errno == ECONNABORTED)
+			{
+				continue;
+			}
+			throw CompilerException(interpolate("Runtime error. Cannot accept connection: {0}", std::strerror(errno)), -1);
+		}
+
+		//a connection keeps its worker until it ends, so an idle or stuck peer
+		//must not hold on to it: recv and send give up after a while
+		timeval timeout{Server::IDLE_SECONDS, 0};
+		if (::setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout)) != 0 or ::setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout)) != 0)
+		{
+			::close(client);
+			continue;
+		}
+
+		pool.submit([this, client]()
+		{
+			this->serve(client);
+			::close(client);
+		});
+	}
+}
+
+void Server::serve(int client)
+{
+	Connection connection(client);
+	std::string header;
+
+	while (connection.read_line(header))
+	{
+		std::istringstream fields(header);
+		std::size_t length = 0;
+		std::string option;
+		bool listing_requested = false, listing_json = false, compact = false, annotate = true;
+		bool well_formed = static_cast<bool>(fields >> length) and length <= Server::MAX_SOURCE;
+
+		while (well_formed and fields >> option)
+		{
+			if (option == "listing")
+			{
+				listing_requested = true;
+			}
+			else if (option == "listing-json")
+			{
+				listing_requested = listing_json = true;
+			}
+			else if (option == "compact")
+			{
+				compact = true;
+			}
+			else if (option == "no-comments")
+			{
+				annotate = false;
+			}
+			else
+			{
+				well_formed = false;
+			}
+		}
+
+		//the source cannot be told apart from the next header, so the connection ends here
+		if (not well_formed)
+		{
+			std::string message = "Runtime error. Malformed request header.\n";
+			connection.write(interpolate("error 0 {0} 0\n", message.size()) + message);
+			return;
+		}
+
+		std::string source;
+		if (not connection.read_exact(length, source))
+		{
+			return;
+		}
+
+		std::ostringstream assembly, diagnostics, listing;
+		bool succeeded = false;
+
+		try
+		{
+			Compiler compiler(source, assembly);
+			compiler.set_diagnostics(&diagnostics);
+			compiler.set_compact(compact);
+			compiler.set_annotate(annotate);
+			compiler.set_listing(listing_requested ? &listing : nullptr, listing_json ? dump_format::JSON : dump_format::TABLE);
+			compiler.set_cache(this->cache);
+			compiler.compile();
+			succeeded = compiler.succeeded();
+		}
+		catch (const std::exception& exc)
+		{
+			diagnostics << exc.what() << std::endl;
+		}
+
+		auto code = succeeded ? assembly.str() : std::string();
+		auto errors = diagnostics.str();
+		auto symtab = listing.str();
+
+		auto response = interpolate("{0} {1} {2} {3}\n", succeeded ? "ok" : "error", code.size(), errors.size(), symtab.size());
+		if (not connection.write(response + code + errors + symtab))
+		{
+			return;
+		}
+	}
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include "subprogramcache.hpp"
+#include <string>
+
+//Keeps a warm compiler process behind a Unix domain socket, so a build service
+//skips fork/exec, sanitizer start-up and static table initialisation per program.
+//
+//request:  "<source length>[ <option>...]\n" followed by the source bytes, where an
+//          option is listing, listing-json, compact or no-comments
+//response: "<ok|error> <assembly length> <diagnostics length> <listing length>\n"
+//          followed by the assembly, the diagnostics and the symtab listing
+//
+//A connection may carry any number of requests. Connections are served
+//concurrently by a pool of workers; one that sends nothing for IDLE_SECONDS,
+//between requests or within one, is closed so that it gives its worker back.
+class Server
+{
+	private:
+		std::string path;
+		unsigned jobs;
+		SubprogramCache* cache; //none when null
+		int listener = -1;
+
+		void serve(int);
+
+	public:
+		Server(std::string path, unsigned jobs, SubprogramCache* cache = nullptr);
+		Server(const Server&) = delete;
+		Server& operator=(const Server&) = delete;
+		~Server();
+
+		void run(); //accepts connections until the process is stopped
+
+		constexpr static std::size_t MAX_SOURCE = 64 * 1024 * 1024;
+		constexpr static int IDLE_SECONDS = 5;
+};
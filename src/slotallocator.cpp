@@ -0,0 +1,169 @@
+#include "slotallocator.hpp"
+#include "symtable.hpp"
+#include <algorithm>
+#include <functional>
+
+void SlotAllocator::allocate(const ir::Function& code, SymTable& symtab)
+{
+	this->scan(code, symtab);
+
+	if (not this->ranges.empty())
+	{
+		this->extend();
+
+		//a function's temporaries all belong to the scope it is compiled in
+		auto area_scope = symtab.get(this->ranges.front().id).m_scope;
+		auto area = this->pack();
+		auto start = symtab.reserve(area_scope, area);
+		auto local = area_scope == scope::LOCAL;
+
+		for (const auto& range : this->ranges)
+		{
+			//locals grow downwards: the first slot lies next to the declared variables
+			symtab.get(range.id).address = local ? start + area - range.offset - range.size : start + range.offset;
+		}
+	}
+
+	this->ranges.clear();
+	this->range_of.clear();
+	this->label_at.clear();
+	this->loops.clear();
+	this->pushed.clear();
+}
+
+void SlotAllocator::scan(const ir::Function& code, SymTable& symtab)
+{
+	int position = 0;
+	for (auto index = code.first(); index != ir::Function::END; index = code[index].next, ++position)
+	{
+		const auto& instruction = code[index];
+
+		if (instruction.is_label())
+		{
+			this->label_at.emplace(instruction.operands[0].id, position);
+			continue;
+		}
+
+		for (int i = 0; i < instruction.count; ++i)
+		{
+			const auto& operand = instruction.operands[i];
+			if (operand.immediate or operand.id < TempAllocator::BASE or operand.id >= LabelAllocator::BASE)
+			{
+				continue;
+			}
+
+			auto [found, added] = this->range_of.try_emplace(operand.id, static_cast<int>(this->ranges.size()));
+			if (added)
+			{
+				const auto& temp = symtab.get(operand.id);
+				if (temp.address != -1)
+				{
+					found->second = -1;
+				}
+				else
+				{
+					this->ranges.push_back(Range{operand.id, position, position, temp.size()});
+				}
+			}
+			else if (found->second != -1)
+			{
+				this->ranges[found->second].end = position;
+			}
+
+			if (instruction.op == opcode::PSH and found->second != -1)
+			{
+				this->pushed.push_back(found->second);
+			}
+		}
+
+		//the callee reads its arguments and writes its result through the
+		//pushed addresses, so they stay live up to the call
+		if (instruction.op == opcode::CALL)
+		{
+			for (auto range : this->pushed)
+			{
+				this->ranges[range].end = position;
+			}
+			this->pushed.clear();
+		}
+
+		//jumps name their target last; a label already passed closes a loop
+		auto is_jump = instruction.op == opcode::JMP or (instruction.op >= opcode::NE and instruction.op <= opcode::EQ);
+		if (is_jump)
+		{
+			auto target = this->label_at.find(instruction.operands[instruction.count - 1].id);
+			if (target != this->label_at.end())
+			{
+				this->loops.emplace_back(target->second, position);
+			}
+		}
+	}
+}
+
+//A value live on entry to a loop head has to survive every pass through the
+//loop, up to the jump back. Stretching may make a range live at the head of an
+//enclosing loop, so this repeats until nothing changes.
+void SlotAllocator::extend()
+{
+	bool changed = not this->loops.empty();
+	while (changed)
+	{
+		changed = false;
+		for (const auto& [head, back] : this->loops)
+		{
+			for (auto& range : this->ranges)
+			{
+				if (range.start < head and range.end >= head and range.end < back)
+				{
+					range.end = back;
+					changed = true;
+				}
+			}
+		}
+	}
+}
+
+//Linear scan: ranges come in order of start, and a slot is released once the
+//last instruction of its range is behind. A range never takes a slot freed by
+//a range ending at its own first instruction, which may still read it.
+int SlotAllocator::pack()
+{
+	int area = 0;
+	auto later_end = std::greater<std::pair<int, int>>();
+
+	for (int i = 0; i < static_cast<int>(this->ranges.size()); ++i)
+	{
+		auto& range = this->ranges[i];
+
+		while (not this->active.empty() and this->active.front().first < range.start)
+		{
+			const auto& done = this->ranges[this->active.front().second];
+			this->free_slots[done.size].push_back(done.offset);
+			std::pop_heap(this->active.begin(), this->active.end(), later_end);
+			this->active.pop_back();
+		}
+
+		auto& slots = this->free_slots[range.size];
+		if (slots.empty())
+		{
+			range.offset = area;
+			area += range.size;
+		}
+		else
+		{
+			range.offset = slots.back();
+			slots.pop_back();
+		}
+
+		this->active.emplace_back(range.end, i);
+		std::push_heap(this->active.begin(), this->active.end(), later_end);
+	}
+
+	this->active.clear();
+	for (auto& [size, slots] : this->free_slots)
+	{
+		slots.clear();
+	}
+
+	return area;
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include "ir.hpp"
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class SymTable;
+
+//Gives the temporaries of a finished function their frame slots. Temporaries
+//whose live ranges do not overlap share a slot, so the frame grows with the
+//most temporaries live at once instead of with all of them. A range runs from
+//the first to the last instruction naming the temporary, or to the call that
+//consumes it when it is pushed; one that is live at the head of a loop is
+//stretched to the loop's backward jump.
+class SlotAllocator
+{
+	private:
+		struct Range
+		{
+			int id;
+			int start;
+			int end;
+			int size = 0;
+			int offset = 0; //from the start of the temporaries' area
+		};
+
+		std::vector<Range> ranges; //in order of start
+		std::unordered_map<int, int> range_of; //temporary id -> index in ranges
+		std::unordered_map<int, int> label_at; //label id -> position
+		std::vector<std::pair<int, int>> loops; //positions of a loop head and of its backward jump
+		std::vector<int> pushed; //ranges of temporaries pushed for the next call
+		std::vector<std::pair<int, int>> active; //end and index of ranges holding a slot, a min-heap on end
+		std::unordered_map<int, std::vector<int>> free_slots; //size -> offsets of released slots
+
+		void scan(const ir::Function&, SymTable&);
+		void extend();
+		int pack(); //area size
+
+	public:
+		void allocate(const ir::Function&, SymTable&); //temporaries placed earlier keep their slots
+};
@@ -0,0 +1,80 @@
+#include "sourcefile.hpp"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+SourceFile::~SourceFile()
+{
+	this->unmap();
+}
+
+bool SourceFile::map(const std::string& file_name)
+{
+	this->unmap();
+
+	int fd = ::open(file_name.c_str(), O_RDONLY);
+	if (fd < 0)
+	{
+		return false;
+	}
+
+	struct stat info;
+	if (::fstat(fd, &info) != 0 or not S_ISREG(info.st_mode))
+	{
+		::close(fd);
+		return false;
+	}
+
+	std::size_t file_size = info.st_size;
+	std::size_t length = file_size + SourceFile::PADDING;
+
+	//zeroed anonymous region with the file mapped over its head: the padding
+	//stays valid even when the file ends exactly on a page boundary.
+	//Pages are private and writable because flex NUL-terminates tokens in place.
+	void* region = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (region == MAP_FAILED)
+	{
+		::close(fd);
+		return false;
+	}
+
+	if (file_size > 0 and ::mmap(region, file_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED)
+	{
+		::munmap(region, length);
+		::close(fd);
+		return false;
+	}
+
+	::close(fd);
+	::madvise(region, length, MADV_SEQUENTIAL);
+
+	this->base = static_cast<char*>(region);
+	this->length = length;
+	return true;
+}
+
+bool SourceFile::is_mapped() const
+{
+	return this->base != nullptr;
+}
+
+char* SourceFile::data() const
+{
+	return this->base;
+}
+
+std::size_t SourceFile::size() const
+{
+	return this->length;
+}
+
+void SourceFile::unmap()
+{
+	if (this->base != nullptr)
+	{
+		::munmap(this->base, this->length);
+		this->base = nullptr;
+		this->length = 0;
+	}
+}
@@ -0,0 +1,27 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+//Source file mapped straight into memory so the lexer can scan it in place
+//instead of copying it through stdio and flex read buffers. The mapping is
+//padded with the two NUL bytes flex requires at the end of an in-place buffer.
+class SourceFile
+{
+	private:
+		char* base = nullptr;
+		std::size_t length = 0; //bytes of the mapping, padding included
+
+	public:
+		SourceFile() = default;
+		SourceFile(const SourceFile&) = delete;
+		SourceFile& operator=(const SourceFile&) = delete;
+		~SourceFile();
+
+		bool map(const std::string&); //false if the file cannot be mapped, e.g. it is not a regular file
+		bool is_mapped() const;
+		char* data() const;
+		std::size_t size() const;
+		void unmap();
+
+		constexpr static std::size_t PADDING = 2;
+};
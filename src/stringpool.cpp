@@ -0,0 +1,92 @@
+#include "stringpool.hpp"
+#include <cstring>
+
+StringPool::StringPool(const StringPool& pool): arena(StringPool::CHUNK_SIZE)
+{
+	*this = pool;
+}
+
+StringPool& StringPool::operator=(const StringPool& pool)
+{
+	if (this != &pool)
+	{
+		this->clear();
+
+		for (auto text : pool.strings)
+		{
+			this->intern(text);
+		}
+	}
+
+	return *this;
+}
+
+int StringPool::intern(std::string_view text)
+{
+	if (auto it = this->ids.find(text); it != this->ids.cend())
+	{
+		return it->second;
+	}
+
+	auto storage = static_cast<char*>(this->arena.allocate(text.size() + 1, 1));
+	std::memcpy(storage, text.data(), text.size());
+	storage[text.size()] = '\0';
+
+	int id = this->size();
+	this->strings.emplace_back(storage, text.size());
+
+	if (this->spare_nodes.empty())
+	{
+		this->ids.emplace(this->strings.back(), id);
+	}
+	else
+	{
+		auto node = std::move(this->spare_nodes.back());
+		this->spare_nodes.pop_back();
+		node.key() = this->strings.back();
+		node.mapped() = id;
+		this->ids.insert(std::move(node));
+	}
+
+	return id;
+}
+
+int StringPool::find(std::string_view text) const
+{
+	auto it = this->ids.find(text);
+	return it == this->ids.cend() ? StringPool::NONE : it->second;
+}
+
+std::string_view StringPool::str(int id) const
+{
+	return this->strings[id];
+}
+
+int StringPool::size() const
+{
+	return this->strings.size();
+}
+
+StringPool::Mark StringPool::mark() const
+{
+	return Mark{this->size(), this->arena.mark()};
+}
+
+void StringPool::release(const Mark& mark)
+{
+	for (int id = mark.size; id < this->size(); ++id)
+	{
+		this->spare_nodes.push_back(this->ids.extract(this->strings[id]));
+	}
+
+	this->strings.resize(mark.size);
+	this->arena.release(mark.arena);
+}
+
+void StringPool::clear()
+{
+	this->ids.clear();
+	this->spare_nodes.clear();
+	this->strings.clear();
+	this->arena.clear();
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include "arena.hpp"
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+class StringPool
+{
+	private:
+		Arena arena; //NUL-terminated spellings, so data() can be handed to C string functions
+		std::vector<std::string_view> strings;
+		std::unordered_map<std::string_view, int> ids;
+		std::vector<std::unordered_map<std::string_view, int>::node_type> spare_nodes; //map nodes of released spellings, reused by intern
+
+	public:
+		struct Mark
+		{
+			int size;
+			Arena::Mark arena;
+		};
+
+		StringPool(): arena(StringPool::CHUNK_SIZE) {};
+		StringPool(const StringPool&);
+		StringPool& operator=(const StringPool&);
+
+		int intern(std::string_view);
+		int find(std::string_view) const;
+		std::string_view str(int) const;
+		int size() const;
+		Mark mark() const;
+		void release(const Mark&); //forgets every spelling interned after the mark
+		void clear();
+
+		constexpr static int NONE =-1;
+		constexpr static std::size_t CHUNK_SIZE = 4 * 1024;
+};
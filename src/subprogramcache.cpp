@@ -0,0 +1,213 @@
+#include "subprogramcache.hpp"
+#include "compilerexception.hpp"
+#include "utils.hpp"
+#include <cctype>
+#include <cerrno>
+#include <cstdio>
+#include <fstream>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+	bool is_word_char(char c)
+	{
+		return std::isalnum(static_cast<unsigned char>(c)) or c == '_';
+	}
+
+	//next identifier or keyword at or after pos; numbers are passed over whole so "1e5" yields no "e5"
+	std::string_view next_word(std::string_view text, std::size_t& pos)
+	{
+		while (pos < text.size())
+		{
+			auto c = static_cast<unsigned char>(text[pos]);
+
+			if (std::isalpha(c) or c == '_')
+			{
+				auto begin = pos;
+				while (pos < text.size() and is_word_char(text[pos]))
+				{
+					++pos;
+				}
+				return text.substr(begin, pos - begin);
+			}
+
+			if (std::isdigit(c))
+			{
+				while (pos < text.size() and is_word_char(text[pos]))
+				{
+					++pos;
+				}
+				continue;
+			}
+
+			++pos;
+		}
+
+		return std::string_view();
+	}
+
+	bool is_subprogram_keyword(std::string_view word)
+	{
+		return word == "function" or word == "procedure";
+	}
+}
+
+SubprogramCache::SubprogramCache(std::string directory): directory(std::move(directory))
+{
+	struct stat info;
+
+	if (::mkdir(this->directory.c_str(), 0777) != 0 and (errno != EEXIST or ::stat(this->directory.c_str(), &info) != 0 or not S_ISDIR(info.st_mode)))
+	{
+		throw CompilerException(interpolate("Runtime error. Cache directory: \"{0}\" cannot be created.", this->directory), -1);
+	}
+}
+
+std::string SubprogramCache::path(const std::string& key) const
+{
+	return this->directory + "/" + key;
+}
+
+std::optional<CachedSubprogram> SubprogramCache::load(const std::string& key)
+{
+	std::ifstream file(this->path(key), std::ios::binary);
+	std::size_t labels_size, code_size, listing_size;
+
+	if (file >> labels_size >> code_size >> listing_size and file.get() == '\n')
+	{
+		CachedSubprogram entry;
+		entry.labels.resize(labels_size);
+		entry.code.resize(code_size);
+		entry.listing.resize(listing_size);
+
+		if (file.read(entry.labels.data(), labels_size) and file.read(entry.code.data(), code_size) and file.read(entry.listing.data(), listing_size))
+		{
+			++this->hits;
+			return entry;
+		}
+	}
+
+	++this->misses;
+	return std::nullopt;
+}
+
+void SubprogramCache::store(const std::string& key, const CachedSubprogram& entry)
+{
+	static std::atomic<unsigned> sequence{0};
+
+	auto target = this->path(key);
+	auto temporary = interpolate("{0}.{1}.{2}.tmp", target, ::getpid(), sequence++);
+	std::ofstream file(temporary, std::ios::binary);
+
+	file << entry.labels.size() << " " << entry.code.size() << " " << entry.listing.size() << "\n"
+		 << entry.labels << entry.code << entry.listing;
+	file.close();
+
+	if (not file or std::rename(temporary.c_str(), target.c_str()) != 0)
+	{
+		std::remove(temporary.c_str());
+	}
+}
+
+long SubprogramCache::hit_count() const
+{
+	return this->hits;
+}
+
+long SubprogramCache::miss_count() const
+{
+	return this->misses;
+}
+
+//FNV-1a over 128 bits; each part is length-prefixed so ("ab", "c") and ("a", "bc") differ
+std::string SubprogramCache::digest(std::string_view seed, std::string_view text)
+{
+	using hash = unsigned __int128;
+	const hash prime = (hash(1) << 88) + 0x13b;
+	hash value = (hash(0x6c62272e07bb0142) << 64) + 0x62b821756295c58d;
+
+	const auto& mix = [&value, &prime](std::string_view bytes)
+	{
+		auto length = std::to_string(bytes.size()) + ":";
+		for (unsigned char c : length)
+		{
+			value = (value ^ c) * prime;
+		}
+		for (unsigned char c : bytes)
+		{
+			value = (value ^ c) * prime;
+		}
+	};
+
+	mix(seed);
+	mix(text);
+
+	static const char digits[] = "0123456789abcdef";
+	std::string hex(32, '0');
+	for (int i = 31; i >= 0; --i, value >>= 4)
+	{
+		hex[i] = digits[static_cast<int>(value & 0xf)];
+	}
+	return hex;
+}
+
+//The language has neither comments nor string literals, so subprograms are
+//delimited by words alone: the header ends at the first ';' outside its
+//parameter list and the body at the end matching the first begin after it.
+std::vector<SubprogramCache::Extent> SubprogramCache::outline(std::string_view source)
+{
+	std::vector<Extent> extents;
+	std::size_t pos = 0;
+
+	for (auto word = next_word(source, pos); not word.empty(); word = next_word(source, pos))
+	{
+		if (not is_subprogram_keyword(word))
+		{
+			continue;
+		}
+
+		Extent extent{pos - word.size(), 0, 0, "", ""};
+		int parentheses = 0;
+
+		for (; pos < source.size() and (source[pos] != ';' or parentheses != 0); ++pos)
+		{
+			parentheses += source[pos] == '(' ? 1 : source[pos] == ')' ? -1 : 0;
+		}
+
+		if (pos == source.size())
+		{
+			break;
+		}
+
+		extent.header_end = ++pos;
+		int nesting = 0;
+
+		for (word = next_word(source, pos); not word.empty(); word = next_word(source, pos))
+		{
+			if (word == "begin")
+			{
+				++nesting;
+			}
+			else if (word == "end" and --nesting <= 0)
+			{
+				break;
+			}
+			else if (nesting == 0 and is_subprogram_keyword(word))
+			{
+				return extents;
+			}
+		}
+
+		if (word.empty() or nesting != 0)
+		{
+			break;
+		}
+
+		extent.body_end = pos;
+		extent.header = SubprogramCache::digest("", source.substr(extent.start, extent.header_end - extent.start));
+		extent.text = SubprogramCache::digest("", source.substr(extent.start, extent.body_end - extent.start));
+		extents.push_back(std::move(extent));
+	}
+
+	return extents;
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+//Generated code of one subprogram, as kept by the cache.
+struct CachedSubprogram
+{
+	std::string labels; //label counters after the subprogram, see SymTable::label_counters
+	std::string code; //entry label through ret, exactly as written to the output
+	std::string listing; //symtab dump printed at the end of the subprogram
+};
+
+//On-disk store of compiled subprograms. Entries are content addressed: the key
+//digests the subprogram text, the declarations it can see, the label numbering
+//it starts from and the compiler version, so a key is only ever looked up by a
+//compilation that would regenerate the same bytes. Files are written under a
+//temporary name and renamed, so concurrent compilations may share a directory.
+class SubprogramCache
+{
+	public:
+		//Where a subprogram lies in its source. Digests are taken up front because
+		//the scanner NUL-terminates tokens in the very buffer it reads.
+		struct Extent
+		{
+			std::size_t start; //offset of the keyword
+			std::size_t header_end; //offset past the header's ';'
+			std::size_t body_end; //offset past the block's end
+			std::string header; //digest of the header text
+			std::string text; //digest of the whole subprogram text
+		};
+
+	private:
+		std::string directory;
+		std::atomic<long> hits{0};
+		std::atomic<long> misses{0};
+
+		std::string path(const std::string&) const;
+
+	public:
+		explicit SubprogramCache(std::string directory);
+		SubprogramCache(const SubprogramCache&) = delete;
+		SubprogramCache& operator=(const SubprogramCache&) = delete;
+
+		std::optional<CachedSubprogram> load(const std::string&); //counts a hit or a miss
+		void store(const std::string&, const CachedSubprogram&); //best effort, a failed write only costs a later miss
+		long hit_count() const;
+		long miss_count() const;
+
+		static std::string digest(std::string_view, std::string_view);
+		static std::vector<Extent> outline(std::string_view); //stops at the first subprogram it cannot delimit
+
+		constexpr static const char* VERSION = "pca-subprogram-2"; //bump whenever generated code changes
+};
@@ -1,26 +1,26 @@
+#pragma once
 #include "enums.hpp"
+#include "typetable.hpp"
 #include "utils.hpp"
-#include <vector> 
 #include <iomanip>
 #include <ostream>
 
+//Hot record scanned by every SymTable query; keep it within 32 bytes.
+//Spellings, array descriptors and parameter lists live in SymTable's side tables.
 struct Symbol 
 {
 	scope m_scope;
 	entry m_entry;
 	dtype m_dtype;
-	std::string name;
 	bool is_reference;
+	int name_id; //spelling interned in SymTable's StringPool
+	int type_id = TypeTable::NONE; //array descriptor in SymTable's TypeTable
 	int symtab_id;
 	int address = 0xff;
-	int start_ind;
-	int stop_ind;
-	std::vector<Symbol> args;
+	int start_ind; //ranges and arrays: lower bound; callables: first parameter in SymTable's signature table
+	int stop_ind; //ranges and arrays: upper bound; callables: one past the last parameter
 	
-	std::string type_to_str() const;
 	int size() const;
+};
 
-	std::string addr_to_str(bool dereference=false, bool callable=false) const;
-
-	friend std::ostream& operator << (std::ostream& out, const Symbol& symbol);
-};
\ No newline at end of file
+static_assert(sizeof(Symbol) <= 32, "Symbol is expected to fit in half a cache line");
@@ -0,0 +1,59 @@
+#include "symbolstore.hpp"
+#include <stdexcept>
+
+SymbolStore::SymbolStore(const SymbolStore& store)
+{
+	*this = store;
+}
+
+SymbolStore& SymbolStore::operator=(const SymbolStore& store)
+{
+	if (this != &store)
+	{
+		this->clear();
+
+		for (int id = 0; id < store.size(); ++id)
+		{
+			this->push_back(store[id]);
+		}
+	}
+
+	return *this;
+}
+
+const Symbol& SymbolStore::at(int id) const
+{
+	if (id < 0 or id >= this->count)
+	{
+		throw std::out_of_range("SymbolStore::at");
+	}
+
+	return (*this)[id];
+}
+
+Symbol& SymbolStore::push_back(const Symbol& symbol)
+{
+	if (this->count == static_cast<int>(this->blocks.size()) * SymbolStore::BLOCK_SIZE)
+	{
+		this->blocks.push_back(std::make_unique<Symbol[]>(SymbolStore::BLOCK_SIZE));
+	}
+
+	auto& slot = (*this)[this->count++];
+	slot = symbol;
+	return slot;
+}
+
+int SymbolStore::size() const
+{
+	return this->count;
+}
+
+void SymbolStore::truncate(int size)
+{
+	this->count = size;
+}
+
+void SymbolStore::clear()
+{
+	this->count = 0;
+}
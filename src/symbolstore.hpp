@@ -0,0 +1,32 @@
+#pragma once
+#include "symbol.hpp"
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+//Symbols packed into fixed blocks. Elements never move, and truncating only
+//rewinds the fill count: blocks stay allocated and are refilled by the next
+//subprogram, so dropping its locals, temps and labels costs no free/malloc.
+class SymbolStore
+{
+	private:
+		std::vector<std::unique_ptr<Symbol[]>> blocks;
+		int count = 0;
+
+		static_assert(std::is_trivially_destructible_v<Symbol>, "truncate() never runs destructors");
+
+	public:
+		SymbolStore() = default;
+		SymbolStore(const SymbolStore&);
+		SymbolStore& operator=(const SymbolStore&);
+
+		Symbol& operator[](int id) { return this->blocks[id / SymbolStore::BLOCK_SIZE][id % SymbolStore::BLOCK_SIZE]; }
+		const Symbol& operator[](int id) const { return this->blocks[id / SymbolStore::BLOCK_SIZE][id % SymbolStore::BLOCK_SIZE]; }
+		const Symbol& at(int) const;
+		Symbol& push_back(const Symbol&);
+		int size() const;
+		void truncate(int);
+		void clear();
+
+		constexpr static int BLOCK_SIZE = 256;
+};
@@ -0,0 +1,169 @@
+#include "symbol.hpp"
+#include "stringpool.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <deque>
+#include <string>
+#include <vector>
+
+//Insert and scan throughput of the symbol record: the former layout
+//(int-sized enums, inline spelling, nested parameter list) against the
+//current hot record with interned names and a side signature table.
+
+namespace
+{
+	enum class legacy_scope {GLOBAL, LOCAL};
+	enum class legacy_entry {VAR, FUNC, PROC, NUM};
+	enum class legacy_dtype {NONE, INT, REAL};
+
+	struct LegacySymbol
+	{
+		legacy_scope m_scope;
+		legacy_entry m_entry;
+		legacy_dtype m_dtype;
+		std::string name;
+		bool is_reference;
+		int symtab_id;
+		int address;
+		int start_ind;
+		int stop_ind;
+		std::vector<LegacySymbol> args;
+	};
+
+	constexpr int symbols_per_round = 4096;
+	constexpr int rounds = 64;
+	constexpr int arity = 3;
+
+	volatile long long sink = 0;
+
+	template<typename Callable>
+	double measure(Callable callable)
+	{
+		auto begin = std::chrono::steady_clock::now();
+		for (int round = 0; round < rounds; ++round)
+		{
+			callable();
+		}
+		std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+		return elapsed.count();
+	}
+
+	std::vector<std::string> make_names()
+	{
+		std::vector<std::string> names;
+		for (int i = 0; i < symbols_per_round; ++i)
+		{
+			names.push_back("identifier_" + std::to_string(i));
+		}
+		return names;
+	}
+
+	void fill_legacy(std::deque<LegacySymbol>& symbols, const std::vector<std::string>& names)
+	{
+		for (int i = 0; i < symbols_per_round; ++i)
+		{
+			LegacySymbol symbol{legacy_scope::LOCAL, legacy_entry::VAR, legacy_dtype::INT, names[i], false, i, -4 * i, 0, 0, {}};
+			if (i % 64 == 0)
+			{
+				symbol.m_entry = legacy_entry::PROC;
+				for (int j = 1; j <= arity and j <= i; ++j)
+				{
+					symbol.args.push_back(symbols[i - j]);
+				}
+			}
+			symbols.push_back(symbol);
+		}
+	}
+
+	void fill_compact(std::deque<Symbol>& symbols, std::vector<Symbol>& signatures, StringPool& pool, const std::vector<std::string>& names)
+	{
+		for (int i = 0; i < symbols_per_round; ++i)
+		{
+			Symbol symbol{.m_scope = scope::LOCAL, .m_entry = entry::VAR, .m_dtype = dtype::INT, .is_reference = false,
+						  .name_id = pool.intern(names[i]), .symtab_id = i, .address = -4 * i, .start_ind = 0, .stop_ind = 0};
+			if (i % 64 == 0)
+			{
+				symbol.m_entry = entry::PROC;
+				symbol.start_ind = signatures.size();
+				for (int j = 1; j <= arity and j <= i; ++j)
+				{
+					signatures.push_back(symbols[i - j]);
+				}
+				symbol.stop_ind = signatures.size();
+			}
+			symbols.push_back(symbol);
+		}
+	}
+
+	void report(const char* what, double legacy, double compact)
+	{
+		const double operations = static_cast<double>(symbols_per_round) * rounds;
+		std::printf("%-8s legacy: %8.2f Msym/s\tcompact: %8.2f Msym/s\tspeedup: %.2fx\n",
+					what, operations / legacy / 1e6, operations / compact / 1e6, legacy / compact);
+	}
+}
+
+int main()
+{
+	const auto names = make_names();
+	std::printf("record size   legacy: %zu bytes\tcompact: %zu bytes\n", sizeof(LegacySymbol), sizeof(Symbol));
+
+	auto legacy_insert = measure([&names]()
+	{
+		std::deque<LegacySymbol> symbols;
+		fill_legacy(symbols, names);
+		sink += symbols.size();
+	});
+
+	auto compact_insert = measure([&names]()
+	{
+		std::deque<Symbol> symbols;
+		std::vector<Symbol> signatures;
+		StringPool pool;
+		fill_compact(symbols, signatures, pool, names);
+		sink += symbols.size();
+	});
+
+	report("insert", legacy_insert, compact_insert);
+
+	//Scans mirror the table's hot loops: match a spelling and look for the enclosing callable.
+	std::deque<LegacySymbol> legacy_symbols;
+	fill_legacy(legacy_symbols, names);
+	const auto& wanted = names[symbols_per_round / 2];
+
+	auto legacy_scan = measure([&legacy_symbols, &wanted]()
+	{
+		auto it = std::find_if(legacy_symbols.crbegin(), legacy_symbols.crend(), [&wanted](const LegacySymbol& sym)
+		{
+			return sym.name == wanted;
+		});
+		auto callables = std::count_if(legacy_symbols.cbegin(), legacy_symbols.cend(), [](const LegacySymbol& sym)
+		{
+			return sym.m_entry == legacy_entry::FUNC or sym.m_entry == legacy_entry::PROC;
+		});
+		sink += it->address + callables;
+	});
+
+	std::deque<Symbol> compact_symbols;
+	std::vector<Symbol> signatures;
+	StringPool pool;
+	fill_compact(compact_symbols, signatures, pool, names);
+
+	auto compact_scan = measure([&compact_symbols, &pool, &wanted]()
+	{
+		const int name_id = pool.find(wanted);
+		auto it = std::find_if(compact_symbols.crbegin(), compact_symbols.crend(), [name_id](const Symbol& sym)
+		{
+			return sym.name_id == name_id;
+		});
+		auto callables = std::count_if(compact_symbols.cbegin(), compact_symbols.cend(), [](const Symbol& sym)
+		{
+			return sym.m_entry == entry::FUNC or sym.m_entry == entry::PROC;
+		});
+		sink += it->address + callables;
+	});
+
+	report("scan", legacy_scan, compact_scan);
+	return 0;
+}
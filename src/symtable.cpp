@@ -1,10 +1,46 @@
 #include "symtable.hpp"
 
 #include <algorithm>
+#include <charconv>
 #include <iomanip>
 #include <ios>
 #include <iterator>
 
+namespace
+{
+	//JSON string literal; names and types are plain ASCII, but escaping keeps the line valid whatever they hold
+	void write_json_string(std::ostream& out, std::string_view text)
+	{
+		out << '"';
+		for (char ch : text)
+		{
+			switch (ch)
+			{
+				case '"':
+				case '\\':
+				{
+					out << '\\' << ch;
+					break;
+				}
+				default:
+				{
+					if (static_cast<unsigned char>(ch) < 0x20)
+					{
+						const char* hex = "0123456789abcdef";
+						out << "\\u00" << hex[(ch >> 4) & 0xf] << hex[ch & 0xf];
+					}
+					else
+					{
+						out << ch;
+					}
+					break;
+				}
+			}
+		}
+		out << '"';
+	}
+}
+
 const std::map<std::string, opcode> SymTable::relops_mulops_signops ={
 	{"*", 		   opcode::MUL},
 	{"div", 	   opcode::DIV},
@@ -97,9 +133,19 @@ void SymTable::clear()
 {
 	this->current_scope = scope::GLOBAL;
 	this->checkpoint = 0;
+	this->names_checkpoint = StringPool::Mark{};
+	this->labels_checkpoint = LabelAllocator::Mark{};
+	this->temps_checkpoint = 0;
 	this->labels.clear();
+	this->temps.clear();
 	this->symbols.clear();
-	this->locals = 0;
+	this->names.clear();
+	this->types.clear();
+	this->signatures.clear();
+	this->current_callable = SymTable::NONE;
+	this->global_index.clear();
+	this->local_index.clear();
+	this->frame.clear();
 }
 
 int SymTable::insert(const enum scope& scope, const std::string& name, const entry& entry, const dtype& dtype, int address, bool is_reference, int start, int stop)
@@ -109,15 +155,15 @@ int SymTable::insert(const enum scope& scope, const std::string& name, const ent
 					.m_scope=scope,
 					.m_entry=entry,
 					.m_dtype=dtype,
-					.name=name,
 					.is_reference = is_reference,
+					.name_id=this->names.intern(name),
 					.symtab_id=id,
 					.address=address,
 					.start_ind = start,
 					.stop_ind = stop
 			   };
 
-	this->symbols.push_back(s);
+	this->index(this->symbols.push_back(s));
 	return id;
 }
 
@@ -134,35 +180,7 @@ int SymTable::insert_constant(const std::string& literal, const dtype& dtype)
 
 int SymTable::insert_temp(const dtype& type, bool is_reference)
 {
-	auto address = this->get_last_addr();
-	if (this->get_scope() == scope::LOCAL)
-	{
-		auto offset = 0;
-		if (is_reference) 
-		{
-			offset = static_cast<int>(varsize::REF);
-		}
-		else 
-		{
-			switch (type) 
-			{
-				case dtype::INT:
-				{
-					offset = static_cast<int>(varsize::INT);
-					break;
-				}
-				case dtype::REAL:
-				{
-					offset = static_cast<int>(varsize::REAL);
-					break;
-				}
-            	default:break;
-            }
-        }
-		address -= offset;
-	}
-
-	return this->insert(this->get_scope(), "$t" + std::to_string(this->locals++), entry::VAR, type, address, is_reference);
+	return this->temps.allocate(this->get_scope(), type, is_reference);
 }
 
 int SymTable::insert_by_token(const std::string& yytext, const token& op, const dtype dtype)
@@ -191,27 +209,30 @@ int SymTable::insert_by_token(const std::string& yytext, const token& op, const
 
 int SymTable::insert_label(const std::string& label)
 {
-	if (this->labels.find(label) == this->labels.cend())
-	{
-		this->labels[label] = 0;
-	}
+	return this->labels.allocate(this->get_scope(), label);
+}
 
-	auto name = label + std::to_string(this->labels[label]);
-	this->labels[label]++;
-	return this->insert(this->get_scope(), name, entry::LABEL, dtype::NONE);
+std::string SymTable::label_counters() const
+{
+	return this->labels.counters_state();
+}
+
+void SymTable::set_label_counters(const std::string& state)
+{
+	this->labels.restore_counters(state);
 }
 
 int SymTable::insert_range(int start, int end)
 {
-	auto start_sym = this->get(start);
-	auto end_sym = this->get(end);
+	const auto& start_sym = this->get(start);
+	const auto& end_sym = this->get(end);
 
 	if(start_sym.m_dtype == dtype::REAL or end_sym.m_dtype == dtype::REAL)
 	{
-		throw CompilerException(interpolate("Syntax error. Range bound types are not (integer, integer) but got: ({0}, {1})", start_sym.type_to_str(), end_sym.type_to_str()), lineno);
+		throw CompilerException(interpolate("Syntax error. Range bound types are not (integer, integer) but got: ({0}, {1})", this->type_to_str(start_sym), this->type_to_str(end_sym)), lineno);
 	}
 
-	auto name = "range(" + start_sym.name + ", " + end_sym.name + ")";
+	auto name = interpolate("range({0}, {1})", this->name(start_sym), this->name(end_sym));
 	auto id = this->lookup(name);
 
 	if(id != SymTable::NONE)
@@ -219,70 +240,53 @@ int SymTable::insert_range(int start, int end)
 		return id;
 	}
 
-	start = std::atoi(start_sym.name.c_str());
-	end = std::atoi(end_sym.name.c_str());
+	start = std::atoi(this->name(start_sym).data());
+	end = std::atoi(this->name(end_sym).data());
 
 	auto op = (start <= end ? opcode::ADD : opcode::SUB);
 
 	return this->insert(this->get_scope(), name, entry::RNG, dtype::INT, static_cast<int>(op), false, start, end);
 }
 
-int SymTable::insert_array_type(std::vector<Symbol>& symbols_vec, dtype& type)
+int SymTable::insert_array_type(const dtype& type, std::vector<Bounds> dims)
 {
-	std::stringstream ss;
-	ss << "array [";
-	int sum = 0;
-	std::for_each(symbols_vec.cbegin(), symbols_vec.cend(), [&ss, &sum](const auto& symbol)
-	{
-		ss << symbol.start_ind;
-		ss << "..";
-		ss << symbol.stop_ind;
-		ss << ", ";
-
-		sum += std::abs(symbol.stop_ind - symbol.start_ind + 1);
-	});
-
-	ss.seekp(-2, std::ios_base::cur);
+	return this->types.intern(type, std::move(dims)) + static_cast<int>(dtype::OBJECT);
+}
 
-	ss << "]";
+int SymTable::insert_array_type(std::vector<int> dims, const dtype& type)
+{
+	std::vector<Bounds> bounds;
 
-	ss << " of " << (type == dtype::INT ? "integer" : "real");
-	
-	auto name = ss.str();
-	
-	if (int out_id = this->lookup(name); out_id != SymTable::NONE)
+	std::transform(dims.cbegin(), dims.cend(), std::back_inserter(bounds), [this](int id)
 	{
-		return out_id + static_cast<int>(dtype::OBJECT);
-	}
+		const auto& symbol = this->get(id);
 
-	auto id = this->insert(this->get_scope(), name, entry::TYPE, type, static_cast<int>(entry::ARR), false);
-	auto& symbol = this->get(id);
+		if(symbol.m_entry != entry::RNG or static_cast<opcode>(symbol.address) != opcode::ADD)
+		{
+			throw CompilerException("Syntax error. Expected ascending range in array definition.", lineno);
+		}
 
-	symbol.args = symbols_vec;
-	symbol.start_ind = 0;
-	symbol.stop_ind = sum - 1; 
-	this->update(symbol);
-	return symbol.symtab_id + static_cast<int>(dtype::OBJECT);
+		return Bounds{.start = symbol.start_ind, .stop = symbol.stop_ind};
+	});
+
+	return this->insert_array_type(type, std::move(bounds));
 }
 
-int SymTable::insert_array_type(std::vector<int> dims, dtype& type)
+const ArrayType& SymTable::array_type(const Symbol& symbol) const
 {
-	std::vector<Symbol> symbols_vec;
-
-	std::transform(dims.cbegin(), dims.cend(), std::inserter(symbols_vec, symbols_vec.begin()), [this](int id)
-	{
-		return this->get(id);
-	});
+	return this->types.get(symbol.type_id);
+}
 
-	if(std::any_of(symbols_vec.cbegin(), symbols_vec.cend(), [](const auto& symbol)
-	{
-		return symbol.m_entry != entry::RNG or static_cast<opcode>(symbol.address) != opcode::ADD;
-	}))
-	{
-		throw CompilerException("Syntax error. Expected ascending range in array definition.", lineno);
-	}
+void SymTable::set_array_type(Symbol& symbol, int type)
+{
+	auto type_id = type - static_cast<int>(dtype::OBJECT);
+	const auto& array_type = this->types.get(type_id);
 
-	return this->insert_array_type(symbols_vec, type);	
+	symbol.m_entry = entry::ARR;
+	symbol.m_dtype = array_type.element;
+	symbol.type_id = type_id;
+	symbol.start_ind = 0;
+	symbol.stop_ind = array_type.elements - 1;
 }
 
 Symbol& SymTable::check_symbol(int id, bool should_exist)
@@ -294,11 +298,11 @@ Symbol& SymTable::check_symbol(int id, bool should_exist)
 	{
 		if(not should_exist)
 		{
-			throw CompilerException(interpolate("Syntax error. Redefinition of {0}: {1}", symbol.m_entry, symbol.name), lineno);
+			throw CompilerException(interpolate("Syntax error. Redefinition of {0}: {1}", symbol.m_entry, this->name(symbol)), lineno);
 		}
 		else
 		{
-			throw CompilerException(interpolate("Syntax error. Access to unbounded identifier: {0}", symbol.name), lineno);
+			throw CompilerException(interpolate("Syntax error. Access to unbounded identifier: {0}", this->name(symbol)), lineno);
 		}
 	}
 
@@ -315,19 +319,7 @@ void SymTable::update_var(int id, int type_id, bool is_reference)
 
 	if (type_id >= offset)
 	{
-		type_id -= offset;
-		auto arr_type = this->get(type_id);
-
-		if (arr_type.m_entry != entry::TYPE)
-		{
-			throw CompilerException(interpolate("Unknown error, expected TYPE entry not: {0}", arr_type.m_entry), lineno);
-		}
-
-		symbol.m_dtype = arr_type.m_dtype;
-		symbol.args = {arr_type};
-		symbol.m_entry = static_cast<entry>(arr_type.address);
-		symbol.start_ind = arr_type.start_ind;
-		symbol.stop_ind = arr_type.stop_ind;
+		this->set_array_type(symbol, type_id);
 	}
 	else
 	{
@@ -338,48 +330,26 @@ void SymTable::update_var(int id, int type_id, bool is_reference)
 	this->update(symbol);
 }
 
-void SymTable::update_addresses_callable(std::vector<int> & args)
+void SymTable::update_addresses_callable(const Symbol& callable, std::vector<int> & args)
 {
-	std::vector<Symbol> arg_symbols;
-	std::transform(args.cbegin(), args.cend(), std::inserter(arg_symbols, arg_symbols.begin()), [this](auto sym_id){return this->get(sym_id);});
 	auto curr = 0;
 
-	auto it = std::find_if(this->symbols.crbegin(), this->symbols.crend(), [](const Symbol& sym)
-	{
-		return sym.m_entry == entry::FUNC or sym.m_entry == entry::PROC;
-	});
-
 	constexpr int offset = static_cast<int>(varsize::REF);
 
-	std::for_each(arg_symbols.begin(), arg_symbols.end(), [this, &curr, &it](Symbol& sym)
+	std::for_each(args.cbegin(), args.cend(), [this, &curr, &callable](auto sym_id)
 	{
-		sym.address = curr + it->address + offset;
+		auto& sym = this->get(sym_id);
+		sym.address = curr + callable.address + offset;
 		curr += sym.size();
-		this->update(sym);
 	});
 }
 
 void SymTable::update_addresses(std::vector<int>& args)
 {
-	std::vector<Symbol> arg_symbols;
-	std::transform(args.cbegin(), args.cend(), std::inserter(arg_symbols, arg_symbols.begin()), [this](auto sym_id){return this->get(sym_id);});
-	
-	auto curr = 0;	
-
-	std::for_each(arg_symbols.begin(), arg_symbols.end(), [this, &curr](Symbol& sym)
+	std::for_each(args.cbegin(), args.cend(), [this](auto sym_id)
 	{
-		if (sym.m_scope == scope::GLOBAL)
-		{
-			sym.address = curr;
-			curr += sym.size();
-		}
-		else
-		{
-			sym.address = curr - sym.size();
-			curr -= sym.size();
-		}
-
-		this->update(sym);
+		auto& sym = this->get(sym_id);
+		sym.address = this->frame.allocate(sym.m_scope, sym.size());
 	});
 }
 
@@ -398,27 +368,17 @@ void SymTable::update_proc_or_fun(int id, entry entry_type, std::vector<int>& ar
 
 	if(type != SymTable::NONE)
 	{
-		auto result_name = interpolate("${0}_result", symbol.name);
+		auto result_name = interpolate("${0}_result", this->name(symbol));
 		auto offset = static_cast<int>(dtype::OBJECT);
 		if (type >= offset)
 		{
-			auto type_id = type - offset;
-			auto type_sym = this->get(type_id);
-
-			if (type_sym.m_entry != entry::TYPE)
-			{
-				throw CompilerException(interpolate("Unknown error, expected TYPE entry not: {0}", type_sym.m_entry), lineno);
-			}
-
 			auto& function_result = this->get(this->insert(scope::LOCAL, 
 														   result_name, 
-														   static_cast<entry>(type_sym.address), 
-														   type_sym.m_dtype, 
+														   entry::ARR, 
+														   dtype::NONE, 
 														   static_cast<int>(this->get_local_scope()),
-														   true,
-														   type_sym.start_ind,
-														   type_sym.stop_ind));
-			function_result.args = {type_sym};
+														   true));
+			this->set_array_type(function_result, type);
 			symbol.m_dtype = dtype::OBJECT;
 		}
 		else 
@@ -427,39 +387,103 @@ void SymTable::update_proc_or_fun(int id, entry entry_type, std::vector<int>& ar
 			this->insert(scope::LOCAL, result_name, entry::VAR, static_cast<dtype>(type), static_cast<int>(this->get_local_scope()), true);
 		}
 	}
-	std::vector<Symbol> map_symbols;
-	std::transform(args.crbegin(), args.crend(), std::back_inserter(map_symbols), [this](auto id)
+	symbol.start_ind = this->signatures.size();
+	std::transform(args.crbegin(), args.crend(), std::back_inserter(this->signatures), [this](auto id)
 	{
 		return this->get(id);
 	});
-
-	symbol.args = map_symbols;
+	symbol.stop_ind = this->signatures.size();
 
 	std::for_each(args.crbegin(), args.crend(), [this](auto id)
 	{
-		Symbol& obj = this->get(id);
-		obj.is_reference = true;
-		this->update(obj);
+		this->get(id).is_reference = true;
 	});
 
-	this->update_addresses_callable(args);
+	this->update_addresses_callable(symbol, args);
+	this->current_callable = symbol.symtab_id;
 	this->update(symbol);
 }
 
-int SymTable::lookup(const std::string& name)
+bool SymTable::is_declared(int id)
+{
+	return id < TempAllocator::BASE;
+}
+
+bool SymTable::is_scope_independent(const Symbol& symbol)
 {
-	const auto it =std::find_if(this->symbols.cbegin(), this->symbols.cend(), [&name, this](const Symbol& s)
+	return symbol.m_entry == entry::FUNC or 
+		   symbol.m_entry == entry::RNG or 
+		   symbol.m_entry == entry::PROC or 
+		   symbol.m_entry == entry::TYPE;
+}
+
+void SymTable::index(const Symbol& symbol)
+{
+	std::vector<int>* level = nullptr;
+
+	if (SymTable::is_scope_independent(symbol) or symbol.m_scope == scope::GLOBAL)
 	{
-		return s.name == name and (
-			s.m_entry == entry::FUNC or 
-			s.m_entry == entry::RNG or 
-			s.m_entry == entry::PROC or 
-			s.m_entry == entry::TYPE or
-			s.m_scope == this->get_scope()
-		);
-	});
+		level = &this->global_index;
+	}
+	else if (symbol.m_scope == scope::LOCAL)
+	{
+		level = &this->local_index;
+	}
+	else
+	{
+		return; //unbound identifiers are never matched by lookup
+	}
+
+	if (static_cast<int>(level->size()) <= symbol.name_id)
+	{
+		level->resize(this->names.size(), SymTable::NONE);
+	}
 
-	return it == this->symbols.cend() ? SymTable::NONE : it - this->symbols.cbegin();
+	//the first declared symbol of given name wins, as in the plain linear scan
+	auto& slot = (*level)[symbol.name_id];
+	if (slot == SymTable::NONE or slot > symbol.symtab_id)
+	{
+		slot = symbol.symtab_id;
+	}
+}
+
+void SymTable::unindex(const Symbol& symbol)
+{
+	for (auto level : {&this->global_index, &this->local_index})
+	{
+		if (symbol.name_id < static_cast<int>(level->size()) and (*level)[symbol.name_id] == symbol.symtab_id)
+		{
+			(*level)[symbol.name_id] = SymTable::NONE;
+		}
+	}
+}
+
+int SymTable::find(int name_id)
+{
+	if (name_id < static_cast<int>(this->global_index.size()))
+	{
+		if (auto id = this->global_index[name_id]; id != SymTable::NONE)
+		{
+			const auto& symbol = this->symbols[id];
+			if (SymTable::is_scope_independent(symbol) or symbol.m_scope == this->get_scope())
+			{
+				return id;
+			}
+		}
+	}
+
+	if (this->get_scope() == scope::LOCAL and name_id < static_cast<int>(this->local_index.size()))
+	{
+		return this->local_index[name_id];
+	}
+
+	return SymTable::NONE;
+}
+
+int SymTable::lookup(const std::string& name)
+{
+	auto name_id = this->names.find(name);
+	return name_id == StringPool::NONE ? SymTable::NONE : this->find(name_id);
 }
 
 Symbol& SymTable::get(const int id)
@@ -468,6 +492,16 @@ Symbol& SymTable::get(const int id)
 	{
 		throw CompilerException(interpolate("Internal error. Invalid data access {0}", id), lineno);
 	}
+	if (id >= LabelAllocator::BASE)
+	{
+		return this->labels.get(id);
+	}
+
+	if (id >= TempAllocator::BASE)
+	{
+		return this->temps.get(id);
+	}
+
 	return this->symbols[id];
 }
 
@@ -478,18 +512,27 @@ void SymTable::update(Symbol& sym)
 		return;
 	}
 
-	this->symbols[sym.symtab_id].address = sym.address;
-	this->symbols[sym.symtab_id].args = sym.args;
-	this->symbols[sym.symtab_id].m_dtype = sym.m_dtype;
-	this->symbols[sym.symtab_id].start_ind = sym.start_ind;
-	this->symbols[sym.symtab_id].stop_ind = sym.stop_ind;
-	this->symbols[sym.symtab_id].m_entry = sym.m_entry;
-	this->symbols[sym.symtab_id].m_scope = sym.m_scope;
-	this->symbols[sym.symtab_id].is_reference = sym.is_reference;
-	this->symbols[sym.symtab_id].name = sym.name;
+	auto& stored = this->get(sym.symtab_id);
+	auto declared = SymTable::is_declared(sym.symtab_id);
+
+	if (declared)
+	{
+		this->unindex(stored);
+	}
+
+	//symbols obtained by get() are mutated in place and only need re-indexing
+	if (&stored != &sym)
+	{
+		stored = sym;
+	}
+
+	if (declared)
+	{
+		this->index(stored);
+	}
 }
 
-dtype SymTable::infer_type(Symbol& first, Symbol& second)
+dtype SymTable::infer_type(const Symbol& first, const Symbol& second)
 {
 	if (first.m_dtype == dtype::NONE or second.m_dtype == dtype::NONE) return dtype::NONE;
 
@@ -499,40 +542,110 @@ dtype SymTable::infer_type(Symbol& first, Symbol& second)
 void SymTable::create_checkpoint()
 {
 	this->checkpoint = this->symbols.size();
+	this->names_checkpoint = this->names.mark();
+	this->labels_checkpoint = this->labels.mark();
+	this->temps_checkpoint = this->temps.size();
 }
 
 void SymTable::restore_checkpoint()
 {	
-	int sz = this->symbols.size();
-	if (this->checkpoint != sz)
+	for (int id = this->checkpoint; id < this->symbols.size(); ++id)
 	{
-		this->symbols.resize(this->checkpoint);
-		this->locals = 0;
+		this->unindex(this->symbols[id]);
 	}
+
+	this->symbols.truncate(this->checkpoint);
+
+	this->labels.release(this->labels_checkpoint);
+	this->temps.release(this->temps_checkpoint);
+
+	//spellings interned since the checkpoint belong to the dropped symbols only
+	this->names.release(this->names_checkpoint);
+
+	this->frame.reset_local();
+}
+
+int SymTable::arity(const Symbol& callable) const
+{
+	return callable.stop_ind - callable.start_ind;
+}
+
+const Symbol& SymTable::parameter(const Symbol& callable, int index) const
+{
+	return this->signatures[callable.start_ind + index];
 }
 
-int SymTable::get_last_addr()
+std::string_view SymTable::name(const Symbol& symbol) const
 {
-	const auto it_to_last_sized = std::find_if(this->symbols.crbegin(), this->symbols.crend(), [](const Symbol& s)
+	if (symbol.symtab_id >= LabelAllocator::BASE)
 	{
-		return s.m_entry == entry::VAR or s.m_entry == entry::ARR;
-	});
+		return this->labels.name(symbol);
+	}
 
-	int addr = 0;
+	if (symbol.symtab_id >= TempAllocator::BASE)
+	{
+		return this->temps.name(symbol);
+	}
+
+	return this->names.str(symbol.name_id);
+}
 
-	if (it_to_last_sized != this->symbols.crend())
+std::string SymTable::type_to_str(const Symbol& symbol) const
+{
+	std::string res = "NONE";
+	if (symbol.m_entry == entry::ARR)
 	{
-		if (it_to_last_sized->m_scope == scope::GLOBAL and it_to_last_sized->address >= 0)
-		{
-			addr = it_to_last_sized->address + it_to_last_sized->size();
-		}
-		else if (it_to_last_sized->m_scope == scope::LOCAL and it_to_last_sized->address < 0)
-		{
-			addr = it_to_last_sized->address;
-		}
+		res = this->types.to_str(symbol.type_id);
+	}
+	else
+	{
+		res = stringify(symbol.m_dtype);	
 	}
+	return res;
+}
 
-	return addr;
+std::string SymTable::addr_to_str(const Symbol& symbol, bool dereference, bool callable) const
+{
+	std::string out;
+	this->append_address(out, symbol, dereference, callable);
+	return out;
+}
+
+void SymTable::append_address(std::string& out, const Symbol& symbol, bool dereference, bool callable) const
+{
+	if (symbol.m_entry == entry::NUM or symbol.m_entry == entry::LABEL or callable)
+	{
+		out.append(1, '#').append(this->name(symbol));
+		return;
+	}
+
+	if (symbol.is_reference and dereference)
+	{
+		out += '*';
+	}
+	else if (not symbol.is_reference and not dereference) 
+	{
+		out += '#';
+	}
+
+	if (symbol.m_scope == scope::LOCAL)
+	{
+		out += symbol.address < 0 ? "BP" : "BP+";
+	}
+
+	char digits[16];
+	auto result = std::to_chars(digits, digits + sizeof(digits), symbol.address);
+	out.append(digits, result.ptr);
+}
+
+int SymTable::frame_size() const
+{
+	return this->frame.frame_size();
+}
+
+int SymTable::reserve(const scope& scope, int size)
+{
+	return this->frame.allocate(scope, size);
 }
 
 std::ostream& operator<<(std::ostream& out, const SymTable& symtab)
@@ -543,18 +656,14 @@ std::ostream& operator<<(std::ostream& out, const SymTable& symtab)
 	{
 		case scope::GLOBAL:
 		{
-			auto program = symtab.symbols.at(0);
-			out << interpolate("SymTable for: program {0}", program.name) << std::endl;
+			const auto& program = symtab.symbols.at(0);
+			out << interpolate("SymTable for: program {0}", symtab.name(program)) << std::endl;
 			break;
 		}
 		case scope::LOCAL:
 		{
-			auto it = std::find_if(symtab.symbols.crbegin(), symtab.symbols.crend(), [](const Symbol& sym)
-			{
-				return sym.m_entry == entry::FUNC or sym.m_entry == entry::PROC;
-			});
-
-			out << interpolate("SymTable for: {0} {1}", it->m_entry, it->name) << std::endl;
+			const auto& callable = symtab.symbols.at(symtab.current_callable);
+			out << interpolate("SymTable for: {0} {1}", callable.m_entry, symtab.name(callable)) << std::endl;
 			break;
 		}
 		default:
@@ -577,13 +686,91 @@ std::ostream& operator<<(std::ostream& out, const SymTable& symtab)
 		<< std::setw(15) << "address" << std::endl;
 	print_line('=', 135);
 
-	const auto& print_symbol = [&out, &print_line](const Symbol& symbol)
+	const auto& print_symbol = [&out, &print_line, &symtab](const Symbol& symbol)
 	{
-		out << symbol;
+		std::string name(symtab.name(symbol));
+		auto type = symtab.type_to_str(symbol);
+		auto addr = symtab.addr_to_str(symbol, not symbol.is_reference);
+
+		out << std::setw(10) << symbol.m_scope << "|" 
+			<< std::setw(30) << (name.length() <= 30 ? name : name.substr(0, 27) + "...") << "|" 
+			<< std::setw(10) << symbol.m_entry << "|" 
+			<< std::setw(15) << symbol.is_reference << "|" 
+			<< std::setw(50) << (type.length() <= 50 ? type : type.substr(0, 47) + "...") << "|" 
+			<< std::setw(15) << (addr.length() <= 15 ? addr : addr.substr(0, 12) + "...") << std::endl;
 		print_line('-', 135);
 	};
 
-	std::for_each(symtab.symbols.cbegin(), symtab.symbols.cend(), print_symbol);
+	for (int id = 0; id < symtab.symbols.size(); ++id)
+	{
+		print_symbol(symtab.symbols[id]);
+	}
 
 	return out;
-}
\ No newline at end of file
+}
+void SymTable::dump(std::ostream& out, dump_format format) const
+{
+	switch (format)
+	{
+		case dump_format::TABLE:
+		{
+			out << *this;
+			break;
+		}
+		case dump_format::JSON:
+		{
+			this->dump_json(out);
+			break;
+		}
+	}
+}
+
+//One line per table: the owner as in the table's title, then every symbol with
+//the table's columns, untruncated.
+//{"scope":"LOCAL","entry":"procedure","name":"sort","symbols":[{"id":0,"scope":"GLOBAL","name":"example",...},...]}
+void SymTable::dump_json(std::ostream& out) const
+{
+	out << "{\"scope\":\"" << this->current_scope << "\"";
+
+	switch (this->current_scope)
+	{
+		case scope::GLOBAL:
+		{
+			out << ",\"entry\":\"program\",\"name\":";
+			write_json_string(out, this->name(this->symbols.at(0)));
+			break;
+		}
+		case scope::LOCAL:
+		{
+			const auto& callable = this->symbols.at(this->current_callable);
+			out << ",\"entry\":\"" << callable.m_entry << "\",\"name\":";
+			write_json_string(out, this->name(callable));
+			break;
+		}
+		default:
+		{
+			break;
+		}
+	}
+
+	out << ",\"symbols\":[";
+
+	for (int id = 0; id < this->symbols.size(); ++id)
+	{
+		const auto& symbol = this->symbols[id];
+
+		out << (id == 0 ? "" : ",") << "{\"id\":" << id
+			<< ",\"scope\":\"" << symbol.m_scope << "\""
+			<< ",\"name\":";
+		write_json_string(out, this->name(symbol));
+		out << ",\"entry\":\"" << symbol.m_entry << "\""
+			<< ",\"reference\":" << (symbol.is_reference ? "true" : "false")
+			<< ",\"type\":";
+		write_json_string(out, this->type_to_str(symbol));
+		out << ",\"address\":";
+		write_json_string(out, this->addr_to_str(symbol, not symbol.is_reference));
+		out << "}";
+	}
+
+	out << "]}\n";
+}
@@ -1,47 +1,90 @@
 #include "symbol.hpp"
+#include "symbolstore.hpp"
+#include "framelayout.hpp"
+#include "stringpool.hpp"
+#include "labelallocator.hpp"
+#include "tempallocator.hpp"
+#include "typetable.hpp"
 #include "compilerexception.hpp"
 #include <algorithm>
 #include <map>
 #include <ostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 #include <map>
 
-
-extern int lineno;
+//how symbol tables are dumped: the wide table for reading, or one JSON object
+//per table and line for tools
+enum class dump_format
+{
+	TABLE,
+	JSON
+};
 
 class SymTable
 {
 	private:
-		std::vector<Symbol> symbols;
-		std::map<std::string, int> labels;
+		SymbolStore symbols; //references stay valid while the table grows
+		StringPool names;
+		TypeTable types;
+		std::vector<Symbol> signatures; //parameter snapshots of callables; their name ids die with the callable's body
+		int current_callable = SymTable::NONE; //callable whose body is being compiled
+		LabelAllocator labels;
+		TempAllocator temps;
+		std::vector<int> global_index; //name id -> symbol visible from every scope
+		std::vector<int> local_index; //name id -> symbol of the current subprogram
+		FrameLayout frame;
 		int checkpoint = 0;
-		int locals = 0;
+		StringPool::Mark names_checkpoint{};
+		LabelAllocator::Mark labels_checkpoint{};
+		int temps_checkpoint = 0;
 		scope current_scope = scope::GLOBAL;
 		local_scope current_local_scope = local_scope::UNBOUND;
 		const static std::map<std::string, opcode> relops_mulops_signops;
 		const static std::map<token, std::string> keywords;
+		const int& lineno; //line counter of the owning compilation, for diagnostics
+
+		static bool is_scope_independent(const Symbol&);
+		static bool is_declared(int);
+		void index(const Symbol&);
+		void unindex(const Symbol&);
+		int find(int);
+		void dump_json(std::ostream&) const;
 		
 	public:
+		explicit SymTable(const int& lineno): lineno(lineno) {};
+
 		Symbol& check_symbol(int, bool=false);
 		std::string keyword(const token);
 		const opcode& op(std::string);
 		Symbol& get(const int);
 		void update(Symbol&);
-		int get_last_addr();
-		int insert_array_type(std::vector<Symbol>&, dtype&);
+		int frame_size() const;
+		int reserve(const scope&, int); //bytes of frame after everything allocated so far, returns the lowest address
+		std::string_view name(const Symbol&) const;
+		int arity(const Symbol&) const;
+		const Symbol& parameter(const Symbol&, int) const;
+		std::string type_to_str(const Symbol&) const;
+		std::string addr_to_str(const Symbol&, bool dereference=false, bool callable=false) const;
+		void append_address(std::string&, const Symbol&, bool dereference=false, bool callable=false) const; //addr_to_str without a temporary
 
 		int insert(const scope&, const std::string&, const entry&,  const dtype&, int = SymTable::NONE, bool is_reference=false, int start=0, int stop=0); //general function
-		int insert_temp(const dtype&, bool is_reference =false); //temporary
+		int insert_temp(const dtype&, bool is_reference =false); //temporary, its slot is given by SlotAllocator
 		int insert_constant(const std::string&, const dtype&); //constant
 		int insert_label(const std::string&); //label
 		int insert_by_token(const std::string&, const token&, const dtype= dtype::NONE); //identifier, constant or operator
 		int insert_range(int, int); //range object
-		int insert_array_type(std::vector<int>, dtype&); //begin array symbol
+		int insert_array_type(std::vector<int>, const dtype&); //array type of range symbols
+		int insert_array_type(const dtype&, std::vector<Bounds>); //array type of bounds
+		const ArrayType& array_type(const Symbol&) const;
+		void set_array_type(Symbol&, int);
 
 		void update_var(int, int, bool is_reference=false); //variable of id and type
 		void update_proc_or_fun(int, entry, std::vector<int>&, int type=SymTable::NONE);
 		void update_addresses(std::vector<int>&);
-		void update_addresses_callable(std::vector<int> &);
+		void update_addresses_callable(const Symbol&, std::vector<int> &);
 
 		int lookup(const std::string&);
 
@@ -56,7 +99,12 @@ class SymTable
 		void create_checkpoint();
 		void restore_checkpoint();
 
-		dtype infer_type(Symbol&, Symbol&);
+		std::string label_counters() const; //label numbering reached so far, see LabelAllocator
+		void set_label_counters(const std::string&);
+
+		dtype infer_type(const Symbol&, const Symbol&);
+
+		void dump(std::ostream&, dump_format) const;
 
 		constexpr static int NONE =-1;
 
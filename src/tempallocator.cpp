@@ -0,0 +1,52 @@
+#include "tempallocator.hpp"
+
+int TempAllocator::allocate(const scope& scope, const dtype& type, bool is_reference)
+{
+	int number = this->next++;
+	int id = TempAllocator::BASE + this->temps.size();
+
+	while (static_cast<int>(this->names.size()) <= number)
+	{
+		this->names.push_back("$t" + std::to_string(this->names.size()));
+	}
+
+	this->temps.push_back(Symbol{
+								   .m_scope = scope,
+								   .m_entry = entry::VAR,
+								   .m_dtype = type,
+								   .is_reference = is_reference,
+								   .name_id = number,
+								   .symtab_id = id,
+								   .address = -1,
+								   .start_ind = 0,
+								   .stop_ind = 0
+								});
+	return id;
+}
+
+Symbol& TempAllocator::get(int id)
+{
+	return this->temps[id - TempAllocator::BASE];
+}
+
+std::string_view TempAllocator::name(const Symbol& temp) const
+{
+	return this->names[temp.name_id];
+}
+
+int TempAllocator::size() const
+{
+	return this->temps.size();
+}
+
+void TempAllocator::release(int size)
+{
+	this->temps.truncate(size);
+	this->next = 0;
+}
+
+void TempAllocator::clear()
+{
+	this->temps.clear();
+	this->next = 0;
+}
@@ -0,0 +1,27 @@
+#pragma once
+#include "enums.hpp"
+#include "symbolstore.hpp"
+#include <deque>
+#include <string>
+#include <string_view>
+
+//Temporaries generated by the emitter, kept apart from declared symbols; ids
+//start at BASE. Numbering restarts in every subprogram, so "$tN" spellings are
+//built once and shared by all of them.
+class TempAllocator
+{
+	private:
+		SymbolStore temps;
+		std::deque<std::string> names; //deque keeps spellings at stable addresses
+		int next = 0; //number of the next temporary in current subprogram
+
+	public:
+		int allocate(const scope&, const dtype&, bool is_reference=false);
+		Symbol& get(int);
+		std::string_view name(const Symbol&) const;
+		int size() const;
+		void release(int); //drops temporaries allocated after given size
+		void clear();
+
+		constexpr static int BASE = 1 << 29;
+};
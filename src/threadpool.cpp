@@ -0,0 +1,133 @@
+#include "threadpool.hpp"
+#include <algorithm>
+
+ThreadPool::ThreadPool(unsigned workers)
+{
+	workers = std::max(workers, 1u);
+
+	for (unsigned i = 0; i < workers; ++i)
+	{
+		this->queues.push_back(std::make_unique<Queue>());
+	}
+
+	for (unsigned i = 0; i < workers; ++i)
+	{
+		this->workers.emplace_back(&ThreadPool::work, this, i);
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(this->mutex);
+		this->stopping = true;
+	}
+
+	this->wake.notify_all();
+
+	for (auto& worker : this->workers)
+	{
+		worker.join();
+	}
+}
+
+void ThreadPool::submit(std::function<void()> task)
+{
+	unsigned target;
+	{
+		//counted before the push, so a worker finishing it can never see pending drop below zero
+		std::lock_guard<std::mutex> lock(this->mutex);
+		target = this->next++ % this->queues.size();
+		++this->queued;
+		++this->pending;
+	}
+
+	{
+		auto& queue = *this->queues[target];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		queue.tasks.push_back(std::move(task));
+	}
+
+	this->wake.notify_one();
+}
+
+bool ThreadPool::take(unsigned worker, std::function<void()>& task)
+{
+	auto count = this->queues.size();
+
+	for (unsigned i = 0; i < count; ++i)
+	{
+		auto& queue = *this->queues[(worker + i) % count];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+
+		if (queue.tasks.empty())
+		{
+			continue;
+		}
+
+		//own work is taken LIFO while it is still cache-warm, stolen work FIFO
+		if (i == 0)
+		{
+			task = std::move(queue.tasks.back());
+			queue.tasks.pop_back();
+		}
+		else
+		{
+			task = std::move(queue.tasks.front());
+			queue.tasks.pop_front();
+		}
+
+		return true;
+	}
+
+	return false;
+}
+
+void ThreadPool::work(unsigned worker)
+{
+	while (true)
+	{
+		std::function<void()> task;
+
+		if (this->take(worker, task))
+		{
+			{
+				std::lock_guard<std::mutex> lock(this->mutex);
+				--this->queued;
+			}
+
+			task();
+
+			std::lock_guard<std::mutex> lock(this->mutex);
+			if (--this->pending == 0)
+			{
+				this->idle.notify_all();
+			}
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(this->mutex);
+		this->wake.wait(lock, [this]() { return this->stopping or this->queued > 0; });
+
+		if (this->stopping and this->queued == 0)
+		{
+			return;
+		}
+	}
+}
+
+void ThreadPool::wait()
+{
+	std::unique_lock<std::mutex> lock(this->mutex);
+	this->idle.wait(lock, [this]() { return this->pending == 0; });
+}
+
+unsigned ThreadPool::size() const
+{
+	return this->workers.size();
+}
+
+unsigned ThreadPool::default_size()
+{
+	return std::max(std::thread::hardware_concurrency(), 1u);
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//Fixed set of workers, each with its own task deque. A worker takes work from
+//the back of its own deque and, when that runs dry, steals from the front of
+//the others, so a few long compilations do not leave the rest of the pool idle.
+//Tasks must not throw.
+class ThreadPool
+{
+	private:
+		struct Queue
+		{
+			std::mutex mutex;
+			std::deque<std::function<void()>> tasks;
+		};
+
+		std::vector<std::unique_ptr<Queue>> queues; //one per worker
+		std::vector<std::thread> workers;
+		std::mutex mutex;
+		std::condition_variable wake;
+		std::condition_variable idle;
+		int queued = 0; //submitted, not yet taken by a worker
+		int pending = 0; //submitted, not yet finished
+		unsigned next = 0; //queue receiving the next submission
+		bool stopping = false;
+
+		bool take(unsigned, std::function<void()>&);
+		void work(unsigned);
+
+	public:
+		explicit ThreadPool(unsigned workers = ThreadPool::default_size());
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+		~ThreadPool();
+
+		void submit(std::function<void()>);
+		void wait(); //blocks until every submitted task has finished
+		unsigned size() const;
+
+		static unsigned default_size();
+};
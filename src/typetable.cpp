@@ -0,0 +1,90 @@
+#include "typetable.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <sstream>
+
+int Bounds::length() const
+{
+	return std::abs(this->stop - this->start + 1);
+}
+
+std::size_t TypeTable::hash(const dtype& element, const std::vector<Bounds>& dims)
+{
+	std::hash<int> hasher;
+	std::size_t seed = hasher(static_cast<int>(element));
+
+	const auto& combine = [&seed, &hasher](int value)
+	{
+		seed ^= hasher(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+	};
+
+	std::for_each(dims.cbegin(), dims.cend(), [&combine](const Bounds& bounds)
+	{
+		combine(bounds.start);
+		combine(bounds.stop);
+	});
+
+	return seed;
+}
+
+int TypeTable::intern(const dtype& element, std::vector<Bounds> dims)
+{
+	auto key = TypeTable::hash(element, dims);
+	auto [first, last] = this->ids.equal_range(key);
+
+	auto it = std::find_if(first, last, [this, &element, &dims](const auto& entry)
+	{
+		const auto& type = this->types[entry.second];
+		return type.element == element and std::equal(type.dims.cbegin(), type.dims.cend(), dims.cbegin(), dims.cend(), [](const Bounds& a, const Bounds& b)
+		{
+			return a.start == b.start and a.stop == b.stop;
+		});
+	});
+
+	if (it != last)
+	{
+		return it->second;
+	}
+
+	int elements = 1;
+	std::for_each(dims.cbegin(), dims.cend(), [&elements](const Bounds& bounds)
+	{
+		elements *= bounds.length();
+	});
+
+	int id = this->types.size();
+	this->types.push_back({.element = element, .dims = std::move(dims), .elements = elements});
+	this->ids.emplace(key, id);
+	return id;
+}
+
+const ArrayType& TypeTable::get(int id) const
+{
+	return this->types[id];
+}
+
+std::string TypeTable::to_str(int id) const
+{
+	const auto& type = this->get(id);
+	std::stringstream ss;
+	ss << "array [";
+
+	for (auto it = type.dims.cbegin(); it != type.dims.cend(); ++it)
+	{
+		if (it != type.dims.cbegin())
+		{
+			ss << ", ";
+		}
+		ss << it->start << ".." << it->stop;
+	}
+
+	ss << "] of " << type.element;
+	return ss.str();
+}
+
+void TypeTable::clear()
+{
+	this->types.clear();
+	this->ids.clear();
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include "enums.hpp"
+#include <cstddef>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct Bounds
+{
+	int start;
+	int stop;
+
+	int length() const;
+};
+
+struct ArrayType
+{
+	dtype element;
+	std::vector<Bounds> dims;
+	int elements; //product of all dimension lengths
+};
+
+class TypeTable
+{
+	private:
+		std::deque<ArrayType> types; //deque keeps types at stable addresses while new ones are interned
+		std::unordered_multimap<std::size_t, int> ids; //structural hash -> type id
+
+		static std::size_t hash(const dtype&, const std::vector<Bounds>&);
+
+	public:
+		int intern(const dtype&, std::vector<Bounds>);
+		const ArrayType& get(int) const;
+		std::string to_str(int) const;
+		void clear();
+
+		constexpr static int NONE =-1;
+};